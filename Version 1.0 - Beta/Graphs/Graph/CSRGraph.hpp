@@ -0,0 +1,217 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// CSRGraph.hpp: Contains the declaration and definition of different data members and methods of the CSRGraph class
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_CSRGRAPH_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_CSRGRAPH_H
+
+#include "MappedArray.hpp"
+
+#include <vector>
+#include <stdexcept>
+
+#include <stdint.h>
+
+// Compressed Sparse Row storage of the directed edges of a Graph
+// The out-edges of vertex u are stored at positions [offsets_[u], offsets_[u+1]) of neighbors_ and weights_,
+// so the memory footprint is O(V+E) and scanning the neighbors of a vertex costs O(degree)
+//
+// Example: Adjacency Matrix                 CSR
+//				 a   b   c   d
+//            a  0   2  -3  -4              offsets_   = { 0, 1, 2, 4, 6 }
+//            b -2   0  -3   1              neighbors_ = { b, d, a, b, a, c }
+//            c  3   3   0  -2              weights_   = { 2, 1, 3, 3, 4, 2 }
+//            d  4  -1   2   0
+//
+// The arrays are MappedArrays, so a CSRGraph either owns them or views them inside a mapped binary Graph file
+template<typename T2>
+class CSRGraph {
+private:
+	int32_t numVertices_;
+	int64_t numEdges_;
+
+	MappedArray<int64_t> offsets_;
+	MappedArray<int32_t> neighbors_;
+	MappedArray<T2> weights_;
+
+public:
+	CSRGraph();
+	CSRGraph(int32_t num_vertices, const std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &edges_list);
+	CSRGraph(MappedArray<int64_t> offsets, MappedArray<int32_t> neighbors, MappedArray<T2> weights);
+	CSRGraph(const CSRGraph<T2> &other);
+	CSRGraph(CSRGraph<T2> &&other);		// Hands the arrays over, so a loaded or transposed CSR is never copied
+	~CSRGraph();
+
+	CSRGraph<T2>& operator=(CSRGraph<T2> other);
+
+	int32_t NumVertices() const		{ return numVertices_; }
+	int64_t NumEdges() const		{ return numEdges_; }
+
+	int64_t EdgeBegin(int32_t vertex) const		{ return offsets_[vertex]; }
+	int64_t EdgeEnd(int32_t vertex) const		{ return offsets_[vertex + 1]; }
+	int32_t OutDegree(int32_t vertex) const		{ return int32_t(offsets_[vertex + 1] - offsets_[vertex]); }
+	int32_t Neighbor(int64_t edge) const		{ return neighbors_[edge]; }
+	const T2& Weight(int64_t edge) const		{ return weights_[edge]; }
+
+	const MappedArray<int64_t>& Offsets() const		{ return offsets_; }
+	const MappedArray<int32_t>& Neighbors() const		{ return neighbors_; }
+	const MappedArray<T2>& Weights() const		{ return weights_; }
+
+	bool FindEdge(int32_t start_vertex, int32_t end_vertex, T2 &edge_weight) const;
+	CSRGraph<T2> Transpose() const;
+	bool IsValid() const;		// O(V+E) check of arrays read from a file: the offsets start at 0 and never decrease, every neighbor is a vertex
+};
+
+
+template<typename T2>
+CSRGraph<T2>::CSRGraph() : numVertices_(0), numEdges_(0), offsets_(std::vector<int64_t>(1, 0))
+{
+
+}
+
+
+// Builds the CSR arrays from a list of (weight, (start_vertex, end_vertex)) directed edges with a counting sort,
+// preserving the relative order of the edges of every vertex
+template<typename T2>
+CSRGraph<T2>::CSRGraph(int32_t num_vertices, const std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &edges_list) : numVertices_(num_vertices), numEdges_(edges_list.size())
+{
+	std::vector<int64_t> offsets(numVertices_ + 1, 0);
+	for (const auto &elem : edges_list) {
+		if ((elem.second.first < 0) || (elem.second.first >= numVertices_) || (elem.second.second < 0) || (elem.second.second >= numVertices_))
+			throw std::out_of_range("ERROR: Edge vertex index is out of range");
+		offsets[elem.second.first + 1] += 1;
+	}
+
+	for (int32_t i = 0; i < numVertices_; i++)		offsets[i + 1] += offsets[i];
+
+	std::vector<int32_t> neighbors(numEdges_);
+	std::vector<T2> weights(numEdges_);
+	std::vector<int64_t> insert_positions(offsets.begin(), offsets.end() - 1);
+	for (const auto &elem : edges_list) {
+		int64_t position = insert_positions[elem.second.first]++;
+		neighbors[position] = elem.second.second;
+		weights[position] = elem.first;
+	}
+
+	offsets_ = MappedArray<int64_t>(std::move(offsets));
+	neighbors_ = MappedArray<int32_t>(std::move(neighbors));
+	weights_ = MappedArray<T2>(std::move(weights));
+}
+
+
+// Takes the arrays as they are (a std::vector converts to an owned MappedArray, without a copy when it is moved in): only
+// their sizes are checked, so mapped arrays are used without touching their pages
+template<typename T2>
+CSRGraph<T2>::CSRGraph(MappedArray<int64_t> offsets, MappedArray<int32_t> neighbors, MappedArray<T2> weights) : offsets_(std::move(offsets)), neighbors_(std::move(neighbors)), weights_(std::move(weights))
+{
+	if ((offsets_.empty()) || (neighbors_.size() != weights_.size()) || (offsets_.back() != int64_t(neighbors_.size())))
+		throw std::invalid_argument("ERROR: Inconsistent CSR offsets, neighbors and weights arrays");
+
+	numVertices_ = int32_t(offsets_.size() - 1);
+	numEdges_ = neighbors_.size();
+}
+
+
+template<typename T2>
+CSRGraph<T2>::CSRGraph(const CSRGraph<T2> &other) : numVertices_(other.numVertices_), numEdges_(other.numEdges_), offsets_(other.offsets_), neighbors_(other.neighbors_), weights_(other.weights_)
+{
+
+}
+
+
+template<typename T2>
+CSRGraph<T2>::CSRGraph(CSRGraph<T2> &&other) : numVertices_(other.numVertices_), numEdges_(other.numEdges_), offsets_(std::move(other.offsets_)), neighbors_(std::move(other.neighbors_)), weights_(std::move(other.weights_))
+{
+	other.numVertices_ = 0;
+	other.numEdges_ = 0;
+}
+
+
+template<typename T2>
+CSRGraph<T2>::~CSRGraph()
+{
+	offsets_.clear();
+	neighbors_.clear();
+	weights_.clear();
+}
+
+
+template<typename T2>
+CSRGraph<T2>& CSRGraph<T2>::operator=(CSRGraph<T2> other)
+{
+	std::swap(numVertices_, other.numVertices_);
+	std::swap(numEdges_, other.numEdges_);
+	std::swap(offsets_, other.offsets_);
+	std::swap(neighbors_, other.neighbors_);
+	std::swap(weights_, other.weights_);
+	return *this;
+}
+
+
+template<typename T2>
+bool CSRGraph<T2>::FindEdge(int32_t start_vertex, int32_t end_vertex, T2 &edge_weight) const
+{
+	for (int64_t e = EdgeBegin(start_vertex); e < EdgeEnd(start_vertex); e++)
+		if (neighbors_[e] == end_vertex) {
+			edge_weight = weights_[e];
+			return true;
+		}
+
+	return false;
+}
+
+
+template<typename T2>
+bool CSRGraph<T2>::IsValid() const
+{
+	if (offsets_[0] != 0)		return false;
+	for (int32_t i = 0; i < numVertices_; i++)
+		if (offsets_[i + 1] < offsets_[i])		return false;
+	for (int64_t e = 0; e < numEdges_; e++)
+		if ((neighbors_[e] < 0) || (neighbors_[e] >= numVertices_))		return false;
+
+	return true;
+}
+
+
+// Returns the graph with all the edges reversed, i.e. the in-edges of every vertex in CSR form
+template<typename T2>
+CSRGraph<T2> CSRGraph<T2>::Transpose() const
+{
+	std::vector<int64_t> offsets(numVertices_ + 1, 0);
+	for (int64_t e = 0; e < numEdges_; e++)		offsets[neighbors_[e] + 1] += 1;
+	for (int32_t i = 0; i < numVertices_; i++)		offsets[i + 1] += offsets[i];
+
+	std::vector<int32_t> neighbors(numEdges_);
+	std::vector<T2> weights(numEdges_);
+	std::vector<int64_t> insert_positions(offsets.begin(), offsets.end() - 1);
+	for (int32_t u = 0; u < numVertices_; u++)
+		for (int64_t e = EdgeBegin(u); e < EdgeEnd(u); e++) {
+			int64_t position = insert_positions[neighbors_[e]]++;
+			neighbors[position] = u;
+			weights[position] = weights_[e];
+		}
+
+	return CSRGraph<T2>(std::move(offsets), std::move(neighbors), std::move(weights));
+}
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_CSRGRAPH_H
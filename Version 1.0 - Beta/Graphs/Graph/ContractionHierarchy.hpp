@@ -0,0 +1,437 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// ContractionHierarchy.hpp: Contains the declaration and definition of different data members and methods of the ContractionHierarchy class
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_CONTRACTIONHIERARCHY_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_CONTRACTIONHIERARCHY_H
+
+#include "CSRGraph.hpp"
+#include "IndexedHeap.hpp"
+#include "SearchSpace.hpp"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+
+#include <stdint.h>
+
+// Contraction Hierarchy (Geisberger et al.) of the directed edges of a CSRGraph with non-negative weights.
+// The vertices are contracted one at a time in the order of their importance: contracting v removes it from the remaining graph
+// and adds a shortcut u-->w of weight w(u,v) + w(v,w) for every pair of neighbours whose shortest path runs through v (no witness
+// path avoiding v is found). ranks_ is the contraction order, and every original or shortcut edge is kept at its lower ranked end:
+//   upwardGraph_:   u-->w with rank(u) < rank(w), stored at u
+//   downwardGraph_: u-->w with rank(u) > rank(w), stored reversed at w
+// so a query only searches upwards, forward from the source in upwardGraph_ and backward from the target in downwardGraph_.
+// middle of a shortcut is the contracted vertex it skips (-1 for an original edge), from which UnpackEdge recovers the original path
+template<typename T2>
+class ContractionHierarchy {
+private:
+	struct Arc {
+		int32_t vertex_;
+		T2 weight_;
+		int32_t middle_;
+	};
+
+	static const int32_t WITNESS_SETTLE_LIMIT = 500;		// A witness search gives up after this many vertices and keeps the shortcut
+	static const uint32_t FILE_VERSION = 1;
+
+	int32_t numVertices_;
+	int64_t numShortcuts_;
+	std::vector<int32_t> ranks_;
+	CSRGraph<T2> upwardGraph_, downwardGraph_;
+	std::vector<int32_t> upwardMiddles_, downwardMiddles_;
+
+	// Contraction state, only alive during Build
+	std::vector<std::vector<Arc> > outArcs_, inArcs_;
+	SearchSpace<T2> witnessSearch_;
+
+	void AddArc(int32_t start_vertex, int32_t end_vertex, const T2 &weight, int32_t middle);
+	void RemoveArc(std::vector<Arc> &arc_list, int32_t vertex);
+	int32_t ContractVertex(int32_t vertex, bool SIMULATE_COND);
+	bool FindArc(int32_t start_vertex, int32_t end_vertex, int32_t &middle) const;
+
+	static void BuildCSR(const std::vector<std::vector<Arc> > &arcs, CSRGraph<T2> &csr, std::vector<int32_t> &middles);
+
+public:
+	ContractionHierarchy();
+	~ContractionHierarchy();
+
+	void Build(const CSRGraph<T2> &csr, const T2 &infinite_weight);
+	void Clear();
+
+	bool Empty() const		{ return ranks_.empty(); }
+	int32_t NumVertices() const		{ return numVertices_; }
+	int64_t NumShortcuts() const		{ return numShortcuts_; }
+	int32_t Rank(int32_t vertex) const		{ return ranks_[vertex]; }
+	const CSRGraph<T2>& UpwardGraph() const		{ return upwardGraph_; }
+	const CSRGraph<T2>& DownwardGraph() const		{ return downwardGraph_; }
+
+	// Appends the original vertices after start_vertex up to end_vertex of the (shortcut) edge start_vertex-->end_vertex
+	void UnpackEdge(int32_t start_vertex, int32_t end_vertex, std::vector<int32_t> &path_list) const;
+
+	// Binary file: "GRCH", version, sizeof(T2), V, ranks, then offsets, neighbors, weights and middles of both graphs
+	void Save(const std::string &file_name) const;
+	void Load(const std::string &file_name);
+};
+
+
+template<typename T2>
+ContractionHierarchy<T2>::ContractionHierarchy() : numVertices_(0), numShortcuts_(0)
+{
+
+}
+
+
+template<typename T2>
+ContractionHierarchy<T2>::~ContractionHierarchy()
+{
+	Clear();
+}
+
+
+template<typename T2>
+void ContractionHierarchy<T2>::Clear()
+{
+	numVertices_ = 0;
+	numShortcuts_ = 0;
+	ranks_.clear();
+	upwardGraph_ = CSRGraph<T2>();
+	downwardGraph_ = CSRGraph<T2>();
+	upwardMiddles_.clear();
+	downwardMiddles_.clear();
+}
+
+
+// Adds start_vertex-->end_vertex to the remaining graph, or lowers the weight of the edge already there
+template<typename T2>
+void ContractionHierarchy<T2>::AddArc(int32_t start_vertex, int32_t end_vertex, const T2 &weight, int32_t middle)
+{
+	for (auto &elem : outArcs_[start_vertex])
+		if (elem.vertex_ == end_vertex) {
+			if (!(weight < elem.weight_))		return;
+			elem.weight_ = weight;
+			elem.middle_ = middle;
+			for (auto &in_elem : inArcs_[end_vertex])
+				if (in_elem.vertex_ == start_vertex) {
+					in_elem.weight_ = weight;
+					in_elem.middle_ = middle;
+				}
+			return;
+		}
+
+	Arc arc = { end_vertex, weight, middle };
+	outArcs_[start_vertex].push_back(arc);
+	arc.vertex_ = start_vertex;
+	inArcs_[end_vertex].push_back(arc);
+}
+
+
+template<typename T2>
+void ContractionHierarchy<T2>::RemoveArc(std::vector<Arc> &arc_list, int32_t vertex)
+{
+	for (size_t i = 0; i < arc_list.size(); i++)
+		if (arc_list[i].vertex_ == vertex) {
+			arc_list[i] = arc_list.back();
+			arc_list.pop_back();
+			return;
+		}
+}
+
+
+// Returns the edge difference of contracting vertex: shortcuts added minus edges removed. With SIMULATE_COND the remaining graph
+// is left untouched, otherwise the shortcuts are added and vertex is cut out of the remaining graph
+template<typename T2>
+int32_t ContractionHierarchy<T2>::ContractVertex(int32_t vertex, bool SIMULATE_COND)
+{
+	std::vector<std::pair<std::pair<int32_t, int32_t>, T2> > shortcut_list;
+	T2 max_out_weight = T2(0);
+	for (const auto &elem : outArcs_[vertex])		max_out_weight = (max_out_weight < elem.weight_) ? elem.weight_ : max_out_weight;
+
+	for (const auto &in_elem : inArcs_[vertex]) {
+		int32_t u = in_elem.vertex_;
+
+		// Witness search: Dijkstra from u that avoids vertex, bounded by the longest path through vertex and by the settle limit
+		T2 max_distance = in_elem.weight_ + max_out_weight;
+		witnessSearch_.Reset();
+		witnessSearch_.Label(u, T2(0), -1);
+		witnessSearch_.heap_.Push(u, T2(0));
+		for (int32_t num_settled = 0; (!witnessSearch_.heap_.Empty()) && (num_settled < WITNESS_SETTLE_LIMIT); num_settled++) {
+			if (max_distance < witnessSearch_.heap_.TopKey())		break;
+			int32_t x = witnessSearch_.heap_.Pop();
+			for (const auto &elem : outArcs_[x]) {
+				if (elem.vertex_ == vertex)		continue;
+				T2 new_distance = witnessSearch_.Distance(x) + elem.weight_;
+				if (new_distance < witnessSearch_.Distance(elem.vertex_)) {
+					witnessSearch_.Label(elem.vertex_, new_distance, x);
+					witnessSearch_.heap_.PushOrDecreaseKey(elem.vertex_, new_distance);
+				}
+			}
+		}
+
+		for (const auto &out_elem : outArcs_[vertex]) {
+			int32_t w = out_elem.vertex_;
+			if (w == u)		continue;
+			T2 path_distance = in_elem.weight_ + out_elem.weight_;
+			if (!(witnessSearch_.Distance(w) <= path_distance))
+				shortcut_list.push_back(std::pair<std::pair<int32_t, int32_t>, T2>(std::pair<int32_t, int32_t>(u, w), path_distance));
+		}
+	}
+
+	int32_t edge_difference = int32_t(shortcut_list.size()) - int32_t(inArcs_[vertex].size()) - int32_t(outArcs_[vertex].size());
+	if (SIMULATE_COND)		return edge_difference;
+
+	for (const auto &elem : inArcs_[vertex])		RemoveArc(outArcs_[elem.vertex_], vertex);
+	for (const auto &elem : outArcs_[vertex])		RemoveArc(inArcs_[elem.vertex_], vertex);
+	for (const auto &elem : shortcut_list)		AddArc(elem.first.first, elem.first.second, elem.second, vertex);
+
+	return edge_difference;
+}
+
+
+// Contracts the vertices in the order of edge difference + contracted neighbours, the second term spreading the contraction
+// uniformly over the graph. The priorities are updated lazily: the top vertex is re-evaluated before it is contracted and
+// pushed back if it no longer beats the next one
+template<typename T2>
+void ContractionHierarchy<T2>::Build(const CSRGraph<T2> &csr, const T2 &infinite_weight)
+{
+	Clear();
+	numVertices_ = csr.NumVertices();
+	outArcs_.assign(numVertices_, std::vector<Arc>());
+	inArcs_.assign(numVertices_, std::vector<Arc>());
+	for (int32_t u = 0; u < numVertices_; u++)
+		for (int64_t e = csr.EdgeBegin(u); e < csr.EdgeEnd(u); e++) {
+			if (csr.Weight(e) < T2(0))
+				throw std::invalid_argument("ERROR: Contraction Hierarchy requires non-negative edge weights");
+			if (csr.Neighbor(e) != u)		AddArc(u, csr.Neighbor(e), csr.Weight(e), -1);
+		}
+
+	witnessSearch_.Resize(numVertices_, infinite_weight);
+	std::vector<int32_t> contracted_neighbours_list(numVertices_, 0);
+	IndexedHeap<int32_t> priority_heap(numVertices_);
+	for (int32_t v = 0; v < numVertices_; v++)		priority_heap.Push(v, ContractVertex(v, true));
+
+	std::vector<std::vector<Arc> > upward_arcs(numVertices_), downward_arcs(numVertices_);
+	ranks_.assign(numVertices_, -1);
+	int64_t num_original_arcs = 0;
+	for (const auto &elem : outArcs_)		num_original_arcs += elem.size();
+
+	for (int32_t rank = 0; rank < numVertices_; ) {
+		int32_t v = priority_heap.Pop();
+		int32_t priority = ContractVertex(v, true) + contracted_neighbours_list[v];
+		if ((!priority_heap.Empty()) && (priority_heap.TopKey() < priority)) {
+			priority_heap.Push(v, priority);
+			continue;
+		}
+
+		// The arcs left at v all lead to vertices contracted later, i.e. of higher rank
+		ranks_[v] = rank++;
+		upward_arcs[v] = outArcs_[v];
+		downward_arcs[v] = inArcs_[v];
+		for (const auto &elem : outArcs_[v])		contracted_neighbours_list[elem.vertex_] += 1;
+		for (const auto &elem : inArcs_[v])		contracted_neighbours_list[elem.vertex_] += 1;
+		ContractVertex(v, false);
+	}
+
+	BuildCSR(upward_arcs, upwardGraph_, upwardMiddles_);
+	BuildCSR(downward_arcs, downwardGraph_, downwardMiddles_);
+	numShortcuts_ = upwardGraph_.NumEdges() + downwardGraph_.NumEdges() - num_original_arcs;
+
+	outArcs_.clear();
+	inArcs_.clear();
+	witnessSearch_ = SearchSpace<T2>();
+}
+
+
+template<typename T2>
+void ContractionHierarchy<T2>::BuildCSR(const std::vector<std::vector<Arc> > &arcs, CSRGraph<T2> &csr, std::vector<int32_t> &middles)
+{
+	std::vector<int64_t> offsets(1, 0);
+	std::vector<int32_t> neighbors;
+	std::vector<T2> weights;
+	middles.clear();
+	for (const auto &elem : arcs) {
+		for (const auto &arc : elem) {
+			neighbors.push_back(arc.vertex_);
+			weights.push_back(arc.weight_);
+			middles.push_back(arc.middle_);
+		}
+		offsets.push_back(int64_t(neighbors.size()));
+	}
+
+	csr = CSRGraph<T2>(offsets, neighbors, weights);
+}
+
+
+// The edge start_vertex-->end_vertex is stored at its lower ranked end, and there is at most one edge per pair of vertices
+template<typename T2>
+bool ContractionHierarchy<T2>::FindArc(int32_t start_vertex, int32_t end_vertex, int32_t &middle) const
+{
+	if (ranks_[start_vertex] < ranks_[end_vertex]) {
+		for (int64_t e = upwardGraph_.EdgeBegin(start_vertex); e < upwardGraph_.EdgeEnd(start_vertex); e++)
+			if (upwardGraph_.Neighbor(e) == end_vertex) {
+				middle = upwardMiddles_[e];
+				return true;
+			}
+	}
+	else {
+		for (int64_t e = downwardGraph_.EdgeBegin(end_vertex); e < downwardGraph_.EdgeEnd(end_vertex); e++)
+			if (downwardGraph_.Neighbor(e) == start_vertex) {
+				middle = downwardMiddles_[e];
+				return true;
+			}
+	}
+
+	return false;
+}
+
+
+// A shortcut u-->w over m stands for u-->m followed by m-->w, both of which are edges of the hierarchy again
+template<typename T2>
+void ContractionHierarchy<T2>::UnpackEdge(int32_t start_vertex, int32_t end_vertex, std::vector<int32_t> &path_list) const
+{
+	std::vector<std::pair<int32_t, int32_t> > edge_stack(1, std::pair<int32_t, int32_t>(start_vertex, end_vertex));
+	while (!edge_stack.empty()) {
+		std::pair<int32_t, int32_t> edge = edge_stack.back();
+		edge_stack.pop_back();
+
+		int32_t middle = -1;
+		if (!FindArc(edge.first, edge.second, middle))
+			throw std::logic_error("ERROR: Edge is not part of the Contraction Hierarchy");
+
+		if (middle == -1)		path_list.push_back(edge.second);
+		else {
+			edge_stack.push_back(std::pair<int32_t, int32_t>(middle, edge.second));
+			edge_stack.push_back(std::pair<int32_t, int32_t>(edge.first, middle));
+		}
+	}
+}
+
+
+template<typename T2>
+void ContractionHierarchy<T2>::Save(const std::string &file_name) const
+{
+	std::ofstream file(file_name.c_str(), std::ios::binary);
+	if (!file)		throw std::runtime_error("ERROR: Cannot open " + file_name + " for writing");
+
+	uint32_t version = FILE_VERSION, weight_size = sizeof(T2);
+	file.write("GRCH", 4);
+	file.write(reinterpret_cast<const char *>(&version), sizeof(version));
+	file.write(reinterpret_cast<const char *>(&weight_size), sizeof(weight_size));
+	file.write(reinterpret_cast<const char *>(&numVertices_), sizeof(numVertices_));
+	file.write(reinterpret_cast<const char *>(&numShortcuts_), sizeof(numShortcuts_));
+	file.write(reinterpret_cast<const char *>(ranks_.data()), sizeof(int32_t) * ranks_.size());
+
+	const CSRGraph<T2> *graph_list[2] = { &upwardGraph_, &downwardGraph_ };
+	const std::vector<int32_t> *middles_list[2] = { &upwardMiddles_, &downwardMiddles_ };
+	for (int32_t i = 0; i < 2; i++) {
+		const CSRGraph<T2> &csr = *graph_list[i];
+		int64_t num_edges = csr.NumEdges();
+		file.write(reinterpret_cast<const char *>(&num_edges), sizeof(num_edges));
+		for (int32_t v = 0; v <= numVertices_; v++) {
+			int64_t offset = (v < numVertices_) ? csr.EdgeBegin(v) : num_edges;
+			file.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+		}
+		for (int64_t e = 0; e < num_edges; e++) {
+			int32_t neighbor = csr.Neighbor(e);
+			file.write(reinterpret_cast<const char *>(&neighbor), sizeof(neighbor));
+		}
+		for (int64_t e = 0; e < num_edges; e++)
+			file.write(reinterpret_cast<const char *>(&csr.Weight(e)), sizeof(T2));
+		file.write(reinterpret_cast<const char *>(middles_list[i]->data()), sizeof(int32_t) * num_edges);
+	}
+
+	if (!file)		throw std::runtime_error("ERROR: Cannot write " + file_name);
+}
+
+
+template<typename T2>
+void ContractionHierarchy<T2>::Load(const std::string &file_name)
+{
+	std::ifstream file(file_name.c_str(), std::ios::binary);
+	if (!file)		throw std::runtime_error("ERROR: Cannot open " + file_name + " for reading");
+
+	char magic[4] = { 0, 0, 0, 0 };
+	uint32_t version = 0, weight_size = 0;
+	file.read(magic, 4);
+	file.read(reinterpret_cast<char *>(&version), sizeof(version));
+	file.read(reinterpret_cast<char *>(&weight_size), sizeof(weight_size));
+	if ((!file) || (std::string(magic, 4) != "GRCH") || (version != FILE_VERSION) || (weight_size != sizeof(T2)))
+		throw std::runtime_error("ERROR: " + file_name + " is not a Contraction Hierarchy file of this version and weight type");
+
+	// The queries index their arrays with the ranks, neighbors and middles read here, so all of them are checked against V
+	// in O(V+E), and the array sizes against the file size before anything is allocated; a corrupt file leaves the hierarchy empty
+	std::streamoff header_end = file.tellg();
+	file.seekg(0, std::ios::end);
+	int64_t file_size = int64_t(file.tellg());
+	file.seekg(header_end);
+
+	Clear();
+	try {
+		file.read(reinterpret_cast<char *>(&numVertices_), sizeof(numVertices_));
+		file.read(reinterpret_cast<char *>(&numShortcuts_), sizeof(numShortcuts_));
+		if ((!file) || (numVertices_ < 0) || (int64_t(sizeof(int32_t)) * numVertices_ > file_size))
+			throw std::runtime_error("ERROR: Corrupt Contraction Hierarchy file " + file_name);
+		ranks_.resize(numVertices_);
+		file.read(reinterpret_cast<char *>(ranks_.data()), sizeof(int32_t) * ranks_.size());
+		if (!file)		throw std::runtime_error("ERROR: Corrupt Contraction Hierarchy file " + file_name);
+
+		std::vector<bool> rank_taken_list(numVertices_, false);
+		for (const auto &elem : ranks_) {
+			if ((elem < 0) || (elem >= numVertices_) || (rank_taken_list[elem]))
+				throw std::runtime_error("ERROR: The ranks in Contraction Hierarchy file " + file_name + " are not a permutation of the vertices");
+			rank_taken_list[elem] = true;
+		}
+
+		CSRGraph<T2> *graph_list[2] = { &upwardGraph_, &downwardGraph_ };
+		std::vector<int32_t> *middles_list[2] = { &upwardMiddles_, &downwardMiddles_ };
+		for (int32_t i = 0; i < 2; i++) {
+			int64_t num_edges = 0;
+			file.read(reinterpret_cast<char *>(&num_edges), sizeof(num_edges));
+			if ((!file) || (num_edges < 0) || (num_edges > file_size / int64_t(2 * sizeof(int32_t) + sizeof(T2))))
+				throw std::runtime_error("ERROR: Corrupt Contraction Hierarchy file " + file_name);
+
+			std::vector<int64_t> offsets(numVertices_ + 1);
+			std::vector<int32_t> neighbors(num_edges);
+			std::vector<T2> weights(num_edges);
+			middles_list[i]->resize(num_edges);
+			file.read(reinterpret_cast<char *>(offsets.data()), sizeof(int64_t) * offsets.size());
+			file.read(reinterpret_cast<char *>(neighbors.data()), sizeof(int32_t) * num_edges);
+			file.read(reinterpret_cast<char *>(weights.data()), sizeof(T2) * num_edges);
+			file.read(reinterpret_cast<char *>(middles_list[i]->data()), sizeof(int32_t) * num_edges);
+			if ((!file) || (offsets.back() != num_edges))		throw std::runtime_error("ERROR: Corrupt Contraction Hierarchy file " + file_name);
+
+			*graph_list[i] = CSRGraph<T2>(std::move(offsets), std::move(neighbors), std::move(weights));
+			if (!graph_list[i]->IsValid())
+				throw std::runtime_error("ERROR: Corrupt Contraction Hierarchy file " + file_name + ", edge offsets or vertex ids out of range");
+			for (const auto &elem : *middles_list[i])
+				if ((elem < -1) || (elem >= numVertices_))
+					throw std::runtime_error("ERROR: Corrupt Contraction Hierarchy file " + file_name + ", skipped vertex ids out of range");
+		}
+	}
+	catch (...) {
+		Clear();
+		throw;
+	}
+}
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_CONTRACTIONHIERARCHY_H
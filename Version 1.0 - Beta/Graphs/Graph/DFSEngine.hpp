@@ -0,0 +1,159 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// DFSEngine.hpp: Contains the declaration and definition of different data members and methods of the DFSEngine class
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_DFSENGINE_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_DFSENGINE_H
+
+#include "CSRGraph.hpp"
+
+#include <vector>
+
+#include <stdint.h>
+
+// Events raised by DFSEngine. A visitor derives from DFSVisitor and hides only the events it needs
+//   DiscoverVertex(u)               u is reached for the first time
+//   TreeEdge(u, v, e)               v is discovered through the edge e = u-->v
+//   BackEdge(u, v, e)               v is an ancestor of u that is still on the DFS stack, i.e. e closes a directed cycle
+//   ForwardOrCrossEdge(u, v, e)     v has already been finished
+//   FinishVertex(u)                 all the out-edges of u have been explored
+//   Stop()                          checked after every event, true aborts the search
+struct DFSVisitor {
+	void DiscoverVertex(int32_t /*vertex*/)		{ }
+	void TreeEdge(int32_t /*start_vertex*/, int32_t /*end_vertex*/, int64_t /*edge*/)		{ }
+	void BackEdge(int32_t /*start_vertex*/, int32_t /*end_vertex*/, int64_t /*edge*/)		{ }
+	void ForwardOrCrossEdge(int32_t /*start_vertex*/, int32_t /*end_vertex*/, int64_t /*edge*/)		{ }
+	void FinishVertex(int32_t /*vertex*/)		{ }
+	bool Stop() const		{ return false; }
+};
+
+
+// Iterative Depth First Search over a CSRGraph. The recursion is replaced by an explicit stack of (vertex, next edge) frames that is
+// allocated once for V frames, so the depth of the search is only limited by the memory of the graph itself. The events are raised
+// in exactly the same order as by the recursive DFS that scans the out-edges of every vertex in CSR order
+template<typename T2>
+class DFSEngine {
+private:
+	enum VertexState : uint8_t { UNDISCOVERED = 0, ON_STACK = 1, FINISHED = 2 };
+
+	const CSRGraph<T2> &csr_;
+	std::vector<std::pair<int32_t, int64_t> > stack_;		// (Vertex, Next out-edge to explore)
+	std::vector<uint8_t> states_;
+	std::vector<int32_t> parents_;		// DFS forest parent, -1 for the roots and the undiscovered vertices
+
+public:
+	DFSEngine(const CSRGraph<T2> &csr);
+	~DFSEngine();
+
+	void Reset();
+	void Exclude(int32_t vertex)		{ states_[vertex] = FINISHED; }		// The search never enters vertex, edges into it are ForwardOrCrossEdges
+
+	bool Discovered(int32_t vertex) const		{ return states_[vertex] != UNDISCOVERED; }
+	bool Finished(int32_t vertex) const		{ return states_[vertex] == FINISHED; }
+	int32_t Parent(int32_t vertex) const		{ return parents_[vertex]; }
+
+	template<typename Visitor>
+	bool Visit(int32_t root_vertex, Visitor &visitor);		// Searches from root_vertex if undiscovered, false if the visitor stopped the search
+	template<typename Visitor>
+	bool VisitAll(Visitor &visitor);		// Searches from every undiscovered vertex in increasing index order
+};
+
+
+template<typename T2>
+DFSEngine<T2>::DFSEngine(const CSRGraph<T2> &csr) : csr_(csr)
+{
+	stack_.reserve(csr_.NumVertices());
+	Reset();
+}
+
+
+template<typename T2>
+DFSEngine<T2>::~DFSEngine()
+{
+	stack_.clear();
+	states_.clear();
+	parents_.clear();
+}
+
+
+template<typename T2>
+void DFSEngine<T2>::Reset()
+{
+	stack_.clear();
+	states_.assign(csr_.NumVertices(), UNDISCOVERED);
+	parents_.assign(csr_.NumVertices(), -1);
+}
+
+
+template<typename T2>
+template<typename Visitor>
+bool DFSEngine<T2>::Visit(int32_t root_vertex, Visitor &visitor)
+{
+	if (states_[root_vertex] != UNDISCOVERED)		return true;
+
+	states_[root_vertex] = ON_STACK;
+	stack_.push_back(std::pair<int32_t, int64_t>(root_vertex, csr_.EdgeBegin(root_vertex)));
+	visitor.DiscoverVertex(root_vertex);
+	if (visitor.Stop())		{ stack_.clear();		return false; }
+
+	while (!stack_.empty()) {
+		int32_t u = stack_.back().first;
+		int64_t &e = stack_.back().second;
+
+		if (e == csr_.EdgeEnd(u)) {
+			stack_.pop_back();
+			states_[u] = FINISHED;
+			visitor.FinishVertex(u);
+			if (visitor.Stop())		{ stack_.clear();		return false; }
+			continue;
+		}
+
+		int64_t edge = e++;
+		int32_t v = csr_.Neighbor(edge);
+		if (states_[v] == UNDISCOVERED) {
+			visitor.TreeEdge(u, v, edge);
+			parents_[v] = u;
+			states_[v] = ON_STACK;
+			stack_.push_back(std::pair<int32_t, int64_t>(v, csr_.EdgeBegin(v)));		// Invalidates e
+			visitor.DiscoverVertex(v);
+		}
+		else if (states_[v] == ON_STACK)		visitor.BackEdge(u, v, edge);
+		else visitor.ForwardOrCrossEdge(u, v, edge);
+
+		if (visitor.Stop())		{ stack_.clear();		return false; }
+	}
+
+	return true;
+}
+
+
+template<typename T2>
+template<typename Visitor>
+bool DFSEngine<T2>::VisitAll(Visitor &visitor)
+{
+	for (int32_t i = 0; i < csr_.NumVertices(); i++)
+		if (!Visit(i, visitor))		return false;
+
+	return true;
+}
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_DFSENGINE_H
@@ -0,0 +1,174 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// DisjointSet.hpp: Contains the declaration and definition of different data members and methods of the DisjointSet class
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_DISJOINTSET_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_DISJOINTSET_H
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+#include <stdint.h>
+
+// Union-Find over the dense vertex indices [0, numElements_) with path compression and union by rank,
+// so any sequence of m Find/Union operations costs O(m * alpha(n)), i.e. practically constant per operation
+class DisjointSet {
+private:
+	std::vector<int32_t> parents_;
+	std::vector<uint8_t> ranks_;		// Upper bound of the height of every tree, never exceeds log2(n)
+	int32_t numSets_;
+
+public:
+	DisjointSet(int32_t num_elements = 0);
+	~DisjointSet();
+
+	void Reset(int32_t num_elements);		// Every element becomes a singleton set
+
+	int32_t NumSets() const		{ return numSets_; }
+
+	int32_t Find(int32_t element);
+	bool Union(int32_t element_1, int32_t element_2);		// false if both elements were already in the same set
+};
+
+
+inline DisjointSet::DisjointSet(int32_t num_elements)
+{
+	Reset(num_elements);
+}
+
+
+inline DisjointSet::~DisjointSet()
+{
+	parents_.clear();
+	ranks_.clear();
+}
+
+
+inline void DisjointSet::Reset(int32_t num_elements)
+{
+	parents_.resize(num_elements);
+	for (int32_t i = 0; i < num_elements; i++)		parents_[i] = i;
+	ranks_.assign(num_elements, 0);
+	numSets_ = num_elements;
+}
+
+
+// Two passes: find the root, then point every element of the path directly at it
+inline int32_t DisjointSet::Find(int32_t element)
+{
+	int32_t root = element;
+	while (parents_[root] != root)		root = parents_[root];
+
+	while (parents_[element] != root) {
+		int32_t next_element = parents_[element];
+		parents_[element] = root;
+		element = next_element;
+	}
+
+	return root;
+}
+
+
+inline bool DisjointSet::Union(int32_t element_1, int32_t element_2)
+{
+	int32_t root_1 = Find(element_1), root_2 = Find(element_2);
+	if (root_1 == root_2)		return false;
+
+	if (ranks_[root_1] < ranks_[root_2])		parents_[root_1] = root_2;
+	else if (ranks_[root_1] > ranks_[root_2])		parents_[root_2] = root_1;
+	else {
+		parents_[root_2] = root_1;
+		++ranks_[root_1];
+	}
+
+	--numSets_;
+	return true;
+}
+
+
+// Union-Find that many threads can Find and Union on at the same time, lock free. Union links the root with the larger index under
+// the root with the smaller one with a compare-and-swap (retried if another thread linked either root first), so the parent pointers
+// can never form a cycle. Find shortens the path it walks by path halving, which is safe to race with other threads
+class ConcurrentDisjointSet {
+private:
+	std::vector<std::atomic<int32_t> > parents_;
+
+public:
+	ConcurrentDisjointSet(int32_t num_elements = 0);
+	~ConcurrentDisjointSet();
+
+	void Reset(int32_t num_elements);		// Not thread safe
+
+	int32_t Find(int32_t element);
+	bool Union(int32_t element_1, int32_t element_2);		// false if both elements were already in the same set
+};
+
+
+inline ConcurrentDisjointSet::ConcurrentDisjointSet(int32_t num_elements)
+{
+	Reset(num_elements);
+}
+
+
+inline ConcurrentDisjointSet::~ConcurrentDisjointSet()
+{
+	parents_.clear();
+}
+
+
+inline void ConcurrentDisjointSet::Reset(int32_t num_elements)
+{
+	std::vector<std::atomic<int32_t> > parents(num_elements);
+	parents_.swap(parents);
+	for (int32_t i = 0; i < num_elements; i++)		parents_[i].store(i, std::memory_order_relaxed);
+}
+
+
+inline int32_t ConcurrentDisjointSet::Find(int32_t element)
+{
+	int32_t parent = parents_[element].load(std::memory_order_acquire);
+	while (parent != element) {
+		int32_t grand_parent = parents_[parent].load(std::memory_order_acquire);
+		if (grand_parent != parent)
+			parents_[element].compare_exchange_weak(parent, grand_parent, std::memory_order_acq_rel);
+		element = parent;
+		parent = parents_[element].load(std::memory_order_acquire);
+	}
+
+	return element;
+}
+
+
+inline bool ConcurrentDisjointSet::Union(int32_t element_1, int32_t element_2)
+{
+	while (true) {
+		int32_t root_1 = Find(element_1), root_2 = Find(element_2);
+		if (root_1 == root_2)		return false;
+		if (root_1 > root_2)		std::swap(root_1, root_2);
+
+		int32_t expected_parent = root_2;
+		if (parents_[root_2].compare_exchange_strong(expected_parent, root_1, std::memory_order_acq_rel))		return true;
+	}
+}
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_DISJOINTSET_H
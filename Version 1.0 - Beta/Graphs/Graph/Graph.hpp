@@ -24,14 +24,37 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_H
 
 #include "Node.hpp"
+#include "CSRGraph.hpp"
+#include "IndexedHeap.hpp"
+#include "ThreadPool.hpp"
+#include "MinPlusKernel.hpp"
+#include "DisjointSet.hpp"
+#include "DFSEngine.hpp"
+#include "GraphResults.hpp"
+#include "GraphPrinter.hpp"
+#include "PathTracer.hpp"
+#include "SearchSpace.hpp"
+#include "ContractionHierarchy.hpp"
+#include "MappedArray.hpp"
+#include "GraphFile.hpp"
+#include "GraphLoader.hpp"
 
 #include <vector>
+#include <memory>
+#include <fstream>
+#include <cstring>
+#include <type_traits>
 #include <tuple>
 #include <queue>
 #include <map>
 #include <set>
 
 #include <algorithm>
+#include <string>
+#include <stdexcept>
+#include <atomic>
+#include <functional>
+#include <random>
 
 #include <stdint.h>
 
@@ -59,59 +82,190 @@ private:
 	// Directed Graph   G: G = -1 * G_Transpose
 	// Simple Directed/Undirected Graph G: Gij = -1 or 1, where i is the row and j is the column
 
+	// Storage:
+	// The matrix passed to the constructor is only read once. The Graph keeps its nodes and the directed edges
+	// (the +ve entries of the adjacency matrix) in Compressed Sparse Row form, so the memory is O(V+E) and
+	// every neighbor scan costs O(degree) instead of O(V). The arrays are MappedArrays, owned for a Graph built in memory and
+	// views of the mapped pages for a Graph loaded from a binary Graph file (GraphFile.hpp)
+
 	int32_t numGraphNodes_;
 	int32_t numGraphEdges_;
 
-	std::vector<std::pair<Node<T1>, std::vector<T2> > > adjacencyMatrix_, incidenceMatrix_;
-	 
-	void CreateIncidenceMatrix();
-	void CreateAdjacencyMatrix();
-	
+	MappedArray<Node<T1> > nodes_;
+	CSRGraph<T2> csr_;
+	CSRGraph<T2> reverseCsr_;		// In-edges of every vertex, for the algorithms that walk the edges backwards
+
+	// Node uuid --> dense node index, sorted by uuid and built once at construction. All the algorithms work on
+	// the dense indices [0, numGraphNodes_) with flat arrays, uuids are only used for input and output
+	MappedArray<std::pair<int64_t, int32_t> > nodeIndexTable_;
+
 	void CreateGraphFromAdjacencyMatrix(const std::vector<std::pair<Node<T1>, std::vector<T2> > >& adjacency_matrix);
 	void CreateGraphFromIncidencematrix(const std::vector<std::pair<Node<T1>, std::vector<T2> > >& incidence_matrix);
+	void CreateNodeIndexTable();
+	void MapGraphFile(const std::string &graph_file_name);
+	T2 GetAdjacencyMatrixEntry(int32_t row_index, int32_t column_index);
 
-	bool CheckNodeNumQueueIsEmpty(std::deque<int64_t> &node_uuid_queue, std::map<int64_t, int32_t> &node_num_map);
-	void DFS(int64_t front_node_uuid, std::vector<std::pair<int64_t, int64_t> > &dfs_traversal_edge_list, std::map<int64_t, int32_t> &node_index_map, std::map<int64_t, int32_t> &node_num_map, int32_t &count);
 	void FindSimpleGraphCycles(std::vector<std::string> &cycle_terminal_vertices_list);	// Find cycles in normal undirected Graph
-	void GraphDepthCycle(int64_t front_node_uuid, std::vector<std::string> &cycle_terminal_vertices_list, std::map<int64_t, int32_t> &node_index_map, std::map<int64_t, int32_t> &node_num_map, std::set<std::pair<int64_t, int64_t> > &edge_list_set, int32_t &count);
 	void FindDigraphCycles(std::vector<std::string> &cycle_terminal_vertices_list); // Find cycles in Directed Graph
-	void DigraphDepthCycle(int64_t front_node_uuid, std::vector<std::pair<int64_t, int64_t> > &cycle_terminal_nodes_list, std::map<int64_t, int32_t> &node_index_map, std::map<int64_t, int32_t> &node_num_map, int32_t &count);
-	void TSort(int64_t front_node_uuid, std::map<int64_t, int32_t> &node_index_map, std::map<int64_t, int32_t> &node_num_map, std::map<int64_t, int32_t> &ts_node_num_map, int32_t &dfs_count, int32_t &ts_count, bool &TS_CYCLE_ABSENT_COND);
+	void FindDigraphCycleComponents(std::vector<std::string> &cycle_components_list);
+
+	// Strongly Connected Components
+	int32_t TarjanAlgorithm(std::vector<int32_t> &component_list, int32_t num_components);
+	int32_t ForwardBackwardTrimAlgorithm(std::vector<int32_t> &component_list);
+	void ParallelReach(const CSRGraph<T2> &csr, int32_t source_vertex, const std::vector<std::atomic<int32_t> > &label_list, std::vector<std::atomic<uint64_t> > &reached_bitmap, ThreadPool &thread_pool);
 	
 	// Shortest Path Algorithms
-	void DijkstraShortestPathAlgorithm(std::vector<std::string> &shortest_path, int32_t start_vertex_index);
-	void FordAlgorithm(std::vector<std::string> &shortest_path, int32_t start_vertex_index);
-	void GenericLabelCorrectingAlgorithm(std::vector<std::string> &shortest_path, int32_t start_vertex_index);
-	void WFIAlgorithm(std::vector<std::string> &shortest_path);
-
-	void GenerateLabelAndNodeMap(std::map<int64_t, std::pair<T2, int64_t> > &label_map, int32_t start_vertex_index, std::map<int64_t, int32_t> &node_index_map);
-	void GenerateShortestPathFromLabelMap(std::map<int64_t, std::pair<T2, int64_t> > &label_map, std::vector<std::string> &shortest_path);
-	int64_t GetMinimalCurrentDistanceNodeID(std::map<int64_t, std::pair<T2, int64_t> > &label_map, std::set<int64_t> &node_uuid_set);
+	template<typename Tracer> void DijkstraShortestPathAlgorithm(ShortestPathResult<T2> &result, int32_t start_vertex_index, Tracer &tracer);
+	template<typename Tracer> void FordAlgorithm(ShortestPathResult<T2> &result, int32_t start_vertex_index, Tracer &tracer);
+	template<typename Tracer> void ParallelBellmanFordAlgorithm(ShortestPathResult<T2> &result, int32_t start_vertex_index, Tracer &tracer);
+	template<typename Tracer> void GenericLabelCorrectingAlgorithm(ShortestPathResult<T2> &result, int32_t start_vertex_index, Tracer &tracer);
+	template<typename Tracer> void DeltaSteppingAlgorithm(ShortestPathResult<T2> &result, int32_t start_vertex_index, Tracer &tracer);
+
+	void ComputeAllPairsDistanceMatrix(std::vector<T2> &distance_matrix);
+	void JohnsonAlgorithm(const std::function<void(int32_t, const std::vector<T2>&)> &callback);
+	bool ComputeJohnsonPotentials(std::vector<T2> &potential_list);
+	void BatchDijkstraAlgorithm(const CSRGraph<T2> &csr, const std::vector<int32_t> &source_list, const std::function<void(ShortestPathResult<T2>&, const std::vector<int32_t>&, int32_t)> &callback);
+	void UpdateWFITile(std::vector<T2> &distance_matrix, int32_t tile_row, int32_t tile_column, int32_t tile_k);
+
+	void InitShortestPathResult(ShortestPathResult<T2> &result, int32_t start_vertex_index);
+	bool HasNegativeWeights();		// Scans csr_ once, the label setting algorithms (Dijkstra and the point-to-point queries) reject negative weights
+	ThreadPool& GetThreadPool();		// Pool of numThreads_ threads, recreated only when SetNumThreads changed the count
+
+	// Point-To-Point Shortest Path algorithms
+	void BidirectionalDijkstraAlgorithm(PointToPointResult<T2> &result);
+	void BuildPointToPointPath(PointToPointResult<T2> &result, int32_t meeting_vertex);
+	void LandmarkAStarAlgorithm(PointToPointResult<T2> &result);
+	void ContractionHierarchyAlgorithm(PointToPointResult<T2> &result);
+	T2 LandmarkLowerBound(int32_t vertex, int32_t target_vertex) const;
+	void SingleSourceDistances(const CSRGraph<T2> &csr, int32_t source_vertex, std::vector<T2> &distance_list, std::vector<int32_t> &parent_list, std::vector<int32_t> &settled_order_list, IndexedHeap<T2> &heap);
+	bool FindPredecessorCycle(const std::vector<int32_t> &predecessor_list, int32_t vertex, std::vector<int32_t> &cycle_node_list);
+	void BuildShortestPathTree(ShortestPathResult<T2> &result);
 
 	// Minimum Spanning Tree algorithms
-	void KruskalAlgorithm(std::vector<std::string> &mst_adjacency_matrix);
-	void DijkstraMSTAlgorithm(std::vector<std::string> &mst_adjacency_matrix);
-	void GenerateEdgesListAndNodeMap(std::vector<std::pair<T2, std::pair<int64_t, int64_t> > > &edges_list, std::map<int64_t, int32_t> &node_uuid_index_map);
-	bool DetectCycle(std::vector<std::pair<int64_t, std::vector<T2> > > &adjacency_matrix, std::vector<std::pair<T2, std::pair<int64_t, int64_t> > > &path_edges_list);
-	void GraphDepthCycle(std::vector<std::pair<int64_t, std::vector<T2> > > &adjacency_matrix, int64_t front_node_uuid, std::map<int64_t, int32_t> &node_index_map, std::map<int64_t, int32_t> &node_num_map, std::vector<std::pair<T2, std::pair<int64_t, int64_t> > > &path_edges_list, int32_t &dfs_count, bool &CYCLE_ABSENT_COND);
-	void EliminateEdgeWithMaximumWeight(std::vector<std::pair<int64_t, std::vector<T2> > > &adjacency_matrix, std::vector<std::pair<T2, std::pair<int64_t, int64_t> > > &path_edges_list, std::map<int64_t, int32_t> &node_uuid_index_map);
+	void KruskalAlgorithm(std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &mst_edges_list);
+	void PrimAlgorithm(std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &mst_edges_list);
+	void BoruvkaAlgorithm(std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &mst_edges_list);
+	void GenerateEdgesList(std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &edges_list);
 
 	int32_t INFINITE_WEIGHT;
 
+	static const int32_t BFS_TOP_DOWN_ALPHA = 14;		// Beamer's heuristic: go bottom-up when m_f > m_u / alpha
+	static const int32_t BFS_BOTTOM_UP_BETA = 24;		//                     go back top-down when n_f < n / beta
+	static const int32_t WFI_TILE_SIZE = 64;		// 64 x 64 tiles: three int32_t/float tiles fit in a 48KB L1/L2 working set
+
+	int32_t numThreads_;		// Threads used by the parallel algorithms, 0 --> One thread per hardware core
+	std::shared_ptr<ThreadPool> threadPool_;		// Created on first use with numThreads_ threads, shared by the copies of this Graph
+	T2 deltaStepWidth_;		// Bucket width of Delta-Stepping, T2(0) --> Average edge weight
+	int32_t labelCorrectingQueuePolicy_;		// Queue discipline of the Generic Label Correcting algorithm
+	int32_t negativeWeightState_;		// -1 --> Not scanned since csr_ last changed;  0 --> No negative edge weight;  1 --> Some negative edge weight
+
+	SearchSpace<T2> forwardSearch_, backwardSearch_;		// Reused by the point-to-point queries, which are therefore not thread safe on one Graph
+
+	// ALT (A*, Landmarks, Triangle inequality): K landmarks and V x K tables, vertex-major, of d(landmark, v) and d(v, landmark)
+	std::vector<int32_t> landmarkList_;
+	std::vector<T2> landmarkFromDistances_;
+	std::vector<T2> landmarkToDistances_;
+
+	ContractionHierarchy<T2> contractionHierarchy_;
+
+	// Log of the mutations since the last CommitUpdates, merged into the CSRs in one O(V + E) pass instead of one rebuild per
+	// mutation. New nodes get the indices [numGraphNodes_, numGraphNodes_ + pendingNodes_.size()). An edge update maps the
+	// directed edge (u, v) to (edge present after the update, weight); the last update of an edge wins
+	std::vector<Node<T1> > pendingNodes_;
+	std::map<int64_t, int32_t> pendingNodeIndexTable_;
+	std::map<std::pair<int32_t, int32_t>, std::pair<bool, T2> > pendingEdgeUpdates_;
+
+	bool FindCurrentEdge(int32_t start_vertex, int32_t end_vertex, T2 &edge_weight) const;		// Committed edges with the pending updates applied
+	void CheckEdgeVertices(int32_t start_vertex, int32_t end_vertex) const;
+
+	Graph(GraphLoader<T1, T2> &graph_loader, int32_t num_threads);		// Takes over the nodes and the CSR parsed by LoadEdgeList
+
 public:
 	Graph(const std::vector<std::pair<Node<T1>, std::vector<T2> > >& matrix, bool flag = 0);
+	Graph(const std::vector<Node<T1> >& nodes, const CSRGraph<T2>& csr);
+	explicit Graph(const std::string &graph_file_name);		// Binary Graph file written by SaveGraphFile, mapped in place
 	~Graph();
 
+	// flag = 0 --> Text edge list;  flag = 1 --> MatrixMarket coordinate file (see GraphLoader). The file is parsed in parallel on
+	// num_threads threads, which the loaded Graph keeps for its parallel algorithms
+	static Graph<T1, T2> LoadEdgeList(const std::string &file_name, int32_t flag = 0, int32_t num_threads = 0);
+
+	void SaveGraphFile(const std::string &graph_file_name) const;
+
+	int32_t GetNodeIndex(int64_t node_uuid) const;		// Returns -1 if there is no node with this uuid
+	const Node<T1>& GetNode(int32_t node_index) const		{ return (node_index < numGraphNodes_) ? nodes_[node_index] : pendingNodes_[node_index - numGraphNodes_]; }
+	int32_t NumNodes() const		{ return numGraphNodes_ + int32_t(pendingNodes_.size()); }		// Including the nodes added since the last commit
+	T2 InfiniteWeight() const		{ return T2(INFINITE_WEIGHT); }
+
 	void DisplayAdjacencyMatrix();
 	void DisplayIncidenceMatrix();
 
+	// The string based methods format the typed results of the overloads below with GraphPrinter
 	void BreadthFirstSearch(std::vector<std::string> &bfs_traversal_edge_list = {});    // Also known as Level Order Traversal
+	void BreadthFirstSearch(TraversalResult &result, int32_t start_vertex_index = 0);	// Direction-Optimizing BFS
+	void ParallelBreadthFirstSearch(TraversalResult &result, int32_t start_vertex_index = 0);
 	void DepthFirstSearch(std::vector<std::pair<int64_t, int64_t> > &dfs_traversal_edge_list);
-	void FindCycles(std::vector<std::string> &cycle_terminal_vertices_list, int32_t flag = 0); // flag = 0 --> Undirected Graph;  flag = 1 --> Directed Graph
+	void DepthFirstSearch(TraversalResult &result);
+	// flag = 0 --> Undirected Graph;  flag = 1 --> Directed Graph;  flag = 2 --> Directed Graph, every set of vertices that share a cycle
+	void FindCycles(std::vector<std::string> &cycle_terminal_vertices_list, int32_t flag = 0);
 	void TopologicalSort(std::vector<std::string> &topological_sort_vertices_list);
-
+	void TopologicalSort(TopologicalSortResult &result);		// Wavefronts of vertices that can be processed concurrently
+	// flag = 0 --> Tarjan;  flag = 1 --> Parallel Forward-Backward-Trim
+	void StronglyConnectedComponents(ComponentResult &result, int32_t flag = 0);
+
+	// flag = 0 --> Dijkstra;  flag = 1 --> Ford;  flag = 2 --> Generic Label Correcting;  flag = 3 --> WFI (All-To-All);
+	// flag = 4 --> Parallel Delta-Stepping;  flag = 5 --> Parallel Bellman-Ford;  flag = 6 --> Johnson (All-To-All)
+	// Ford (flag = 1), Generic Label Correcting and Parallel Bellman-Ford accept negative edge weights and report a reachable negative cycle in the result,
+	// Dijkstra and Delta-Stepping throw std::invalid_argument on a negative edge weight
+	// The Tracer overloads report the relaxations, queue operations and iterations to a tracer policy (PathTracer.hpp),
+	// the other overloads use NullPathTracer whose empty calls compile away
 	void ShortestPathAlgorithm(std::vector<std::string> &shortest_path, int32_t flag = 0, int32_t start_vertex_index=0);
+	template<typename Tracer>
+	void ShortestPathAlgorithm(std::vector<std::string> &shortest_path, int32_t flag, int32_t start_vertex_index, Tracer &tracer);
+	void ShortestPathAlgorithm(ShortestPathResult<T2> &result, int32_t flag = 0, int32_t start_vertex_index = 0);		// Single source flags only
+	template<typename Tracer>
+	void ShortestPathAlgorithm(ShortestPathResult<T2> &result, int32_t flag, int32_t start_vertex_index, Tracer &tracer);
+	// flag = 0 --> WFI;  flag = 1 --> Johnson, for sparse Graphs. Both accept negative edge weights and throw on a negative cycle
+	// A result whose matrix already holds V x V entries is filled in place
+	void AllPairsShortestPath(AllPairsShortestPathResult<T2> &result, int32_t flag = 0);
+	// Johnson, streaming every source row instead of storing the matrix: callback(source_vertex, distance_list) runs on the
+	// pool threads, concurrently for different sources, and distance_list is only valid during the call
+	void AllPairsShortestPath(const std::function<void(int32_t, const std::vector<T2>&)> &callback);
+	// Dijkstra from every vertex of source_list, concurrently on the thread pool over the read-only CSR, non-negative weights only.
+	// callback(result, thread_id) runs on the pool threads for one source at a time per thread; result is the scratch of that
+	// thread and is only valid during the call
+	void MultiSourceShortestPath(const std::vector<int32_t> &source_list, const std::function<void(const ShortestPathResult<T2>&, int32_t)> &callback);
+	// flag = 0 --> Bidirectional Dijkstra;  flag = 1 --> A* with landmarks (PreprocessLandmarks first);
+	// flag = 2 --> Contraction Hierarchy (BuildContractionHierarchy or LoadContractionHierarchy first).
+	// Stops as soon as the target distance is proven, non-negative weights only
+	void PointToPointShortestPath(PointToPointResult<T2> &result, int32_t start_vertex_index, int32_t target_vertex_index, int32_t flag = 0);
+	// flag = 0 --> Farthest landmark selection;  flag = 1 --> Avoid landmark selection
+	void PreprocessLandmarks(int32_t num_landmarks, int32_t flag = 0);
+	const std::vector<int32_t>& GetLandmarks() const		{ return landmarkList_; }
+	void BuildContractionHierarchy();
+	void SaveContractionHierarchy(const std::string &file_name) const;
+	void LoadContractionHierarchy(const std::string &file_name);
+	const ContractionHierarchy<T2>& GetContractionHierarchy() const		{ return contractionHierarchy_; }
+	// flag = 0 --> Kruskal;  flag = 2 --> Prim (flag = 1, the former Dijkstra MST, also runs Prim);  flag = 3 --> Parallel Boruvka
 	void MinimumSpanningTree(std::vector<std::string> &mst_adjacency_matrix, int32_t flag = 0);
+	void MinimumSpanningTree(SpanningTreeResult<T2> &result, int32_t flag = 0);
+
+	// Mutations of directed edges (add both directions for an undirected Graph). They are logged and reach the algorithms at the
+	// next CommitUpdates, which every algorithm calls first, so a batch of updates between two queries costs one O(V + E) merge.
+	// The nodes are visible at once through NumNodes, GetNode and GetNodeIndex. Parallel edges u --> v count as one edge
+	int32_t AddVertex(const Node<T1> &node);		// Returns the index of the new node
+	void AddEdge(int32_t start_vertex_index, int32_t end_vertex_index, const T2 &edge_weight);
+	void RemoveEdge(int32_t start_vertex_index, int32_t end_vertex_index);
+	void UpdateWeight(int32_t start_vertex_index, int32_t end_vertex_index, const T2 &edge_weight);
+	// Merges the logged mutations into the CSRs (owned from then on, also for a mapped Graph) and drops the landmarks and the
+	// Contraction Hierarchy, which no longer match the Graph
+	void CommitUpdates();
+	int32_t NumPendingUpdates() const		{ return int32_t(pendingNodes_.size() + pendingEdgeUpdates_.size()); }
+
+	void SetNumThreads(int32_t num_threads)		{ numThreads_ = num_threads; }
+	void SetDeltaSteppingWidth(const T2& delta)		{ deltaStepWidth_ = delta; }
+	// flag = 0 --> FIFO;  flag = 1 --> Small Label First;  flag = 2 --> Large Label Last;  flag = 3 --> SLF + LLL (default)
+	void SetLabelCorrectingQueuePolicy(int32_t flag)		{ labelCorrectingQueuePolicy_ = flag; }
 
 };
 
@@ -119,843 +273,2393 @@ public:
 template<typename T1, typename T2>
 Graph<T1,T2>::~Graph()
 {
-	adjacencyMatrix_.clear();
-	incidenceMatrix_.clear();
+	nodes_.clear();
 }
 
 
 template<typename T1, typename T2>
-Graph<T1, T2>::Graph(const std::vector<std::pair<Node<T1>, std::vector<T2> > >& matrix, bool flag /* = 0 */) : INFINITE_WEIGHT(0xFFFFFFF)
+Graph<T1, T2>::Graph(const std::vector<std::pair<Node<T1>, std::vector<T2> > >& matrix, bool flag /* = 0 */) : INFINITE_WEIGHT(0xFFFFFFF), numThreads_(0), deltaStepWidth_(T2(0)), labelCorrectingQueuePolicy_(3), negativeWeightState_(-1)
 {
 	if (flag)	CreateGraphFromIncidencematrix(matrix);
 	else CreateGraphFromAdjacencyMatrix(matrix);
+
+	reverseCsr_ = csr_.Transpose();
+	CreateNodeIndexTable();
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::CreateGraphFromAdjacencyMatrix(const std::vector<std::pair<Node<T1>, std::vector<T2> > >& adjacency_matrix)
+Graph<T1, T2>::Graph(const std::vector<Node<T1> >& nodes, const CSRGraph<T2>& csr) : nodes_(nodes), csr_(csr), INFINITE_WEIGHT(0xFFFFFFF), numThreads_(0), deltaStepWidth_(T2(0)), labelCorrectingQueuePolicy_(3), negativeWeightState_(-1)
 {
-	adjacencyMatrix_ = adjacency_matrix;
-	CreateIncidenceMatrix();
-}
+	if (int32_t(nodes_.size()) != csr_.NumVertices())
+		throw std::invalid_argument("ERROR: Number of nodes does not match the number of CSR vertices");
 
+	numGraphNodes_ = nodes_.size();
+	numGraphEdges_ = int32_t(csr_.NumEdges());
 
-template<typename T1, typename T2>
-void Graph<T1, T2>::CreateGraphFromIncidencematrix(const std::vector<std::pair<Node<T1>, std::vector<T2> > >& incidence_matrix)
-{ 
-	incidenceMatrix_ = incidence_matrix;
-	CreateAdjacencyMatrix();
+	reverseCsr_ = csr_.Transpose();
+	CreateNodeIndexTable();
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::CreateIncidenceMatrix()
+Graph<T1, T2>::Graph(const std::string &graph_file_name) : INFINITE_WEIGHT(0xFFFFFFF), numThreads_(0), deltaStepWidth_(T2(0)), labelCorrectingQueuePolicy_(3), negativeWeightState_(-1)
 {
-	numGraphNodes_ = adjacencyMatrix_.size();
-	numGraphEdges_ = 0;
-
-	for (int32_t i = 0; i<numGraphNodes_; i++)
-		for (int32_t j = i + 1; j < numGraphNodes_; j++)
-			numGraphEdges_ += (adjacencyMatrix_[i].second[j] != 0) ? 1 : 0;
-	
-	std::vector<std::pair<Node<T1>, std::vector<T2> > > incidence_matrix(numGraphNodes_);
-	for (int32_t i = 0; i < numGraphNodes_; i++) {
-		incidence_matrix[i].first = adjacencyMatrix_[i].first;
-		std::vector<T2> edge_weights(numGraphEdges_, 0);
-		incidence_matrix[i].second = edge_weights;
-	}
-	
-	int32_t count = 0;
-	for (int32_t i = 0; (i < numGraphNodes_)&&(count<numGraphEdges_); i++) {
-		for (int32_t j = i+1; (j < numGraphNodes_)&&(count<numGraphEdges_); j++)
-			if (adjacencyMatrix_[i].second[j] != 0) {
-				incidence_matrix[i].second[count] = adjacencyMatrix_[i].second[j];
-				incidence_matrix[j].second[count] = adjacencyMatrix_[j].second[i];
-				count += 1;
-			}
-	}
-
-	incidenceMatrix_ = incidence_matrix;
+	MapGraphFile(graph_file_name);
 }
 
+
 template<typename T1, typename T2>
-void Graph<T1, T2>::CreateAdjacencyMatrix()
+Graph<T1, T2>::Graph(GraphLoader<T1, T2> &graph_loader, int32_t num_threads) : nodes_(std::move(graph_loader.Nodes())), csr_(std::move(graph_loader.Csr())), INFINITE_WEIGHT(0xFFFFFFF), numThreads_(num_threads), deltaStepWidth_(T2(0)), labelCorrectingQueuePolicy_(3), negativeWeightState_(-1)
 {
-	numGraphEdges_ = incidenceMatrix_[0].second.size();
-	numGraphNodes_ = incidenceMatrix_.size();
+	numGraphNodes_ = int32_t(nodes_.size());
+	numGraphEdges_ = int32_t(csr_.NumEdges());
 
-	std::vector<std::pair<Node<T1>, std::vector<T2> > > adjacency_matrix(numGraphNodes_);
-	for (int32_t i = 0; i < numGraphNodes_; i++)	{
-		adjacency_matrix[i].first = incidenceMatrix_[i].first;
-		adjacency_matrix[i].second = std::vector<T2>(numGraphNodes_, 0);          // Just check if we need to remove a 0
-	}
+	reverseCsr_ = csr_.Transpose();
+	CreateNodeIndexTable();
+}
 
-	for (int32_t i = 0; i < numGraphEdges_; i++) {
-		std::vector<int32_t> node_indices;
-		for (int32_t j = 0; j < numGraphNodes_; j++)
-			if (incidenceMatrix_[j].second[i] != 0)		node_indices.push_back(j);
-		adjacency_matrix[node_indices[0]].second[node_indices[1]] = incidenceMatrix_[node_indices[0]].second[i];
-		adjacency_matrix[node_indices[1]].second[node_indices[0]] = incidenceMatrix_[node_indices[1]].second[i];
-	}
 
-	adjacencyMatrix_ = adjacency_matrix;
+// Apart from MapGraphFile, so that loading a text file does not require trivially copyable nodes
+template<typename T1, typename T2>
+Graph<T1, T2> Graph<T1, T2>::LoadEdgeList(const std::string &file_name, int32_t flag /* = 0 */, int32_t num_threads /* = 0 */)
+{
+	GraphLoader<T1, T2> graph_loader(num_threads);
+	graph_loader.Load(file_name, flag);
+	return Graph<T1, T2>(graph_loader, num_threads);
 }
 
 
+// Zero parsing load: the CSR arrays and the node tables are views into the file mapping, so there is no Transpose and no sort,
+// and processes that map the same file share the pages through the page cache. The algorithms index their arrays with the
+// offsets, neighbors and node indices of the file, so one O(V+E) pass checks them (both CSRs, and a node index table sorted
+// by uuid that matches the nodes) before the Graph is used
 template<typename T1, typename T2>
-void Graph<T1, T2>::DisplayAdjacencyMatrix()
+void Graph<T1, T2>::MapGraphFile(const std::string &graph_file_name)
 {
-	std::cout << std::endl << "\t";
-	for (const auto& elem : adjacencyMatrix_)		std::cout << elem.first.uuid_ << "\t";
-	
-	for (const auto& elem : adjacencyMatrix_) {
-		std::cout << std::endl << elem.first.uuid_ << "\t";
-		for (const auto& elem2 : elem.second)		std::cout << elem2 << "\t";
+	static_assert(std::is_trivially_copyable<Node<T1> >::value && std::is_trivially_copyable<T2>::value, "Graph files need trivially copyable nodes and weights");
+
+	std::shared_ptr<const MappedFile> file = std::make_shared<MappedFile>(graph_file_name);
+	GraphFileHeader header;
+	if (file->Size() < sizeof(header))		throw std::runtime_error("ERROR: " + graph_file_name + " is not a Graph file");
+	std::memcpy(&header, file->Data(), sizeof(header));
+	if ((std::string(header.magic_, 8) != "GRAPHCSR") || (header.version_ != GraphFileHeader::VERSION) || (header.endianTag_ != GraphFileHeader::ENDIAN_TAG) ||
+		(header.nodeSize_ != sizeof(Node<T1>)) || (header.weightSize_ != sizeof(T2)))
+		throw std::runtime_error("ERROR: " + graph_file_name + " is not a Graph file of this version, byte order, node and weight type");
+	if ((header.numVertices_ < 0) || (header.numVertices_ > INT32_MAX) || (header.numEdges_ < 0) || (header.numEdges_ > INT32_MAX))
+		throw std::runtime_error("ERROR: Corrupt Graph file " + graph_file_name);
+
+	uint64_t num_vertices = header.numVertices_, num_edges = header.numEdges_;
+	const uint64_t section_sizes[GraphFileHeader::NUM_SECTIONS] = { sizeof(int64_t) * (num_vertices + 1), sizeof(int32_t) * num_edges, sizeof(T2) * num_edges,
+		sizeof(int64_t) * (num_vertices + 1), sizeof(int32_t) * num_edges, sizeof(T2) * num_edges, sizeof(std::pair<int64_t, int32_t>) * num_vertices, sizeof(Node<T1>) * num_vertices };
+	for (int32_t i = 0; i < GraphFileHeader::NUM_SECTIONS; i++)
+		if ((header.sectionSizes_[i] != section_sizes[i]) || (header.sectionOffsets_[i] % GraphFileHeader::SECTION_ALIGNMENT != 0) ||
+			(header.sectionOffsets_[i] > file->Size()) || (header.sectionSizes_[i] > file->Size() - header.sectionOffsets_[i]))
+			throw std::runtime_error("ERROR: Corrupt Graph file " + graph_file_name);
+
+	MappedArray<int64_t> forward_offsets = MapGraphFileSection<int64_t>(file, header, GraphFileHeader::FORWARD_OFFSETS);
+	MappedArray<int64_t> reverse_offsets = MapGraphFileSection<int64_t>(file, header, GraphFileHeader::REVERSE_OFFSETS);
+	if ((forward_offsets.back() != int64_t(num_edges)) || (reverse_offsets.back() != int64_t(num_edges)))
+		throw std::runtime_error("ERROR: Corrupt Graph file " + graph_file_name + ", edge offsets out of range");
+
+	csr_ = CSRGraph<T2>(std::move(forward_offsets), MapGraphFileSection<int32_t>(file, header, GraphFileHeader::FORWARD_NEIGHBORS),
+		MapGraphFileSection<T2>(file, header, GraphFileHeader::FORWARD_WEIGHTS));
+	reverseCsr_ = CSRGraph<T2>(std::move(reverse_offsets), MapGraphFileSection<int32_t>(file, header, GraphFileHeader::REVERSE_NEIGHBORS),
+		MapGraphFileSection<T2>(file, header, GraphFileHeader::REVERSE_WEIGHTS));
+	nodeIndexTable_ = MapGraphFileSection<std::pair<int64_t, int32_t> >(file, header, GraphFileHeader::NODE_INDEX_TABLE);
+	nodes_ = MapGraphFileSection<Node<T1> >(file, header, GraphFileHeader::NODES);
+
+	numGraphNodes_ = int32_t(num_vertices);
+	numGraphEdges_ = int32_t(num_edges);
+
+	bool VALID_COND = (csr_.NumVertices() == numGraphNodes_) && (reverseCsr_.NumVertices() == numGraphNodes_) && (csr_.IsValid()) && (reverseCsr_.IsValid());
+	for (int32_t i = 0; (i < numGraphNodes_) && (VALID_COND); i++) {
+		int32_t node_index = nodeIndexTable_[i].second;
+		VALID_COND = (node_index >= 0) && (node_index < numGraphNodes_) && (nodes_[node_index].uuid_ == nodeIndexTable_[i].first) &&
+			((i == 0) || (nodeIndexTable_[i - 1].first < nodeIndexTable_[i].first));
 	}
-
-	std::cout << "\n\n";
+	if (!VALID_COND)		throw std::runtime_error("ERROR: Corrupt Graph file " + graph_file_name + ", edge offsets, vertex ids or node index table out of range");
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::DisplayIncidenceMatrix()
+void Graph<T1, T2>::SaveGraphFile(const std::string &graph_file_name) const
 {
-	std::cout << std::endl << "\t";
-	for (int32_t i = 0; i < incidenceMatrix_[0].second.size(); i++) {
-		std::vector<int32_t> node_indices;
-		for (int32_t j = 0; j < numGraphNodes_; j++)
-			if (incidenceMatrix_[j].second[i] != 0)	node_indices.push_back(j);
-
-		std::cout << incidenceMatrix_[node_indices[0]].first.uuid_ << "-" << incidenceMatrix_[node_indices[1]].first.uuid_ << "\t";
+	static_assert(std::is_trivially_copyable<Node<T1> >::value && std::is_trivially_copyable<T2>::value, "Graph files need trivially copyable nodes and weights");
+	if (NumPendingUpdates() > 0)
+		throw std::logic_error("ERROR: The Graph has pending updates, CommitUpdates before SaveGraphFile");
+
+	GraphFileHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic_, "GRAPHCSR", 8);
+	header.version_ = GraphFileHeader::VERSION;
+	header.endianTag_ = GraphFileHeader::ENDIAN_TAG;
+	header.nodeSize_ = sizeof(Node<T1>);
+	header.weightSize_ = sizeof(T2);
+	header.numVertices_ = numGraphNodes_;
+	header.numEdges_ = csr_.NumEdges();
+
+	const char *section_data[GraphFileHeader::NUM_SECTIONS] = {
+		reinterpret_cast<const char *>(csr_.Offsets().data()), reinterpret_cast<const char *>(csr_.Neighbors().data()), reinterpret_cast<const char *>(csr_.Weights().data()),
+		reinterpret_cast<const char *>(reverseCsr_.Offsets().data()), reinterpret_cast<const char *>(reverseCsr_.Neighbors().data()), reinterpret_cast<const char *>(reverseCsr_.Weights().data()),
+		reinterpret_cast<const char *>(nodeIndexTable_.data()), reinterpret_cast<const char *>(nodes_.data()) };
+	const uint64_t section_sizes[GraphFileHeader::NUM_SECTIONS] = {
+		sizeof(int64_t) * csr_.Offsets().size(), sizeof(int32_t) * csr_.Neighbors().size(), sizeof(T2) * csr_.Weights().size(),
+		sizeof(int64_t) * reverseCsr_.Offsets().size(), sizeof(int32_t) * reverseCsr_.Neighbors().size(), sizeof(T2) * reverseCsr_.Weights().size(),
+		sizeof(std::pair<int64_t, int32_t>) * nodeIndexTable_.size(), sizeof(Node<T1>) * nodes_.size() };
+
+	uint64_t position = sizeof(header);
+	for (int32_t i = 0; i < GraphFileHeader::NUM_SECTIONS; i++) {
+		position = (position + GraphFileHeader::SECTION_ALIGNMENT - 1) / GraphFileHeader::SECTION_ALIGNMENT * GraphFileHeader::SECTION_ALIGNMENT;
+		header.sectionOffsets_[i] = position;
+		header.sectionSizes_[i] = section_sizes[i];
+		position += section_sizes[i];
 	}
 
-	for (const auto& elem : incidenceMatrix_) {
-		std::cout << std::endl << elem.first.uuid_ << "\t";
-		for (const auto& elem2 : elem.second)		std::cout << elem2 << "\t";
+	std::ofstream file(graph_file_name.c_str(), std::ios::binary);
+	if (!file)		throw std::runtime_error("ERROR: Cannot open " + graph_file_name + " for writing");
+
+	const char padding[GraphFileHeader::SECTION_ALIGNMENT] = { 0 };
+	file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	position = sizeof(header);
+	for (int32_t i = 0; i < GraphFileHeader::NUM_SECTIONS; i++) {
+		file.write(padding, header.sectionOffsets_[i] - position);
+		if (section_sizes[i] > 0)		file.write(section_data[i], section_sizes[i]);
+		position = header.sectionOffsets_[i] + section_sizes[i];
 	}
 
-	std::cout << "\n\n";
+	if (!file)		throw std::runtime_error("ERROR: Cannot write " + graph_file_name);
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::BreadthFirstSearch(std::vector<std::string> &bfs_traversal_edge_list)
+void Graph<T1, T2>::CreateGraphFromAdjacencyMatrix(const std::vector<std::pair<Node<T1>, std::vector<T2> > >& adjacency_matrix)
 {
-	bfs_traversal_edge_list = {};
+	numGraphNodes_ = adjacency_matrix.size();
 	
-	Node<T1> start_node = adjacencyMatrix_[0].first;
-	std::deque<int64_t> node_uuid_queue;
-	std::map<int64_t, int32_t> node_num_map;
-	std::map<int64_t, int32_t> node_index_map;
-	for (int32_t i = 0; i < adjacencyMatrix_.size(); i++)	{
-		node_num_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, 0)); 
-		node_index_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, i));
+	std::vector<Node<T1> > nodes;
+	std::vector<int64_t> offsets(numGraphNodes_ + 1, 0);
+	for (int32_t i = 0; i < numGraphNodes_; i++) {
+		nodes.push_back(adjacency_matrix[i].first);
+		offsets[i + 1] = offsets[i];
+		for (int32_t j = 0; j < numGraphNodes_; j++)
+			offsets[i + 1] += (adjacency_matrix[i].second[j] > 0 /* !=0 && !-ve*/) ? 1 : 0;
 	}
-	
-	int32_t count = 0;
-	node_uuid_queue.push_back(start_node.uuid_);
-	while (!node_uuid_queue.empty()) {
-		int64_t front_node_uuid = node_uuid_queue.front();
-		node_uuid_queue.pop_front();
-		node_num_map[front_node_uuid] = ++count;
-		for (int32_t j = 0; j < adjacencyMatrix_.size(); j++)
-			if ((adjacencyMatrix_[node_index_map[front_node_uuid]].second[j] > 0 /* !=0 && !-ve*/)&&(node_num_map[adjacencyMatrix_[j].first.uuid_] == 0)) 
-			{
-				node_num_map[adjacencyMatrix_[j].first.uuid_] = ++count;
-				node_uuid_queue.push_back(adjacencyMatrix_[j].first.uuid_);
-				std::string edge = std::to_string(front_node_uuid) + "-" + std::to_string(adjacencyMatrix_[j].first.uuid_);
-				bfs_traversal_edge_list.push_back(edge);
+
+	std::vector<int32_t> neighbors;
+	std::vector<T2> weights;
+	neighbors.reserve(offsets[numGraphNodes_]);
+	weights.reserve(offsets[numGraphNodes_]);
+	for (int32_t i = 0; i < numGraphNodes_; i++)
+		for (int32_t j = 0; j < numGraphNodes_; j++)
+			if (adjacency_matrix[i].second[j] > 0 /* !=0 && !-ve*/) {
+				neighbors.push_back(j);
+				weights.push_back(adjacency_matrix[i].second[j]);
 			}
-	}
+
+	nodes_ = MappedArray<Node<T1> >(std::move(nodes));
+	csr_ = CSRGraph<T2>(std::move(offsets), std::move(neighbors), std::move(weights));
+	numGraphEdges_ = int32_t(csr_.NumEdges());
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::DepthFirstSearch(std::vector<std::pair<int64_t, int64_t> > &dfs_traversal_edge_list)
-{
-	dfs_traversal_edge_list = {};
-	
-	std::deque<int64_t> node_uuid_queue;
-	std::map<int64_t, int32_t> node_num_map;
-	std::map<int64_t, int32_t> node_index_map;
-	for (int32_t i = 0; i < adjacencyMatrix_.size(); i++)	{
-		node_num_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, 0));
-		node_index_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, i));
-		node_uuid_queue.push_back(adjacencyMatrix_[i].first.uuid_);
-	}
+void Graph<T1, T2>::CreateGraphFromIncidencematrix(const std::vector<std::pair<Node<T1>, std::vector<T2> > >& incidence_matrix)
+{ 
+	numGraphNodes_ = incidence_matrix.size();
+	int32_t num_incidence_edges = (numGraphNodes_ > 0) ? incidence_matrix[0].second.size() : 0;
 
-	int32_t count = 0;
-	while (!CheckNodeNumQueueIsEmpty(node_uuid_queue, node_num_map)) {
-		int64_t front_node_uuid = node_uuid_queue.front();
-		node_uuid_queue.pop_front();
+	std::vector<Node<T1> > nodes;
+	for (const auto &elem : incidence_matrix)	nodes.push_back(elem.first);
+	nodes_ = MappedArray<Node<T1> >(std::move(nodes));
 
-		DFS(front_node_uuid, dfs_traversal_edge_list, node_index_map, node_num_map, count);
+	std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > edges_list;
+	for (int32_t i = 0; i < num_incidence_edges; i++) {
+		std::vector<int32_t> node_indices;
+		for (int32_t j = 0; j < numGraphNodes_; j++)
+			if (incidence_matrix[j].second[i] != 0)		node_indices.push_back(j);
+		if (node_indices.size() != 2)
+			throw std::invalid_argument("ERROR: Every column of the Incidence Matrix must connect exactly two nodes");
+
+		if (incidence_matrix[node_indices[0]].second[i] > 0)
+			edges_list.push_back(std::pair<T2, std::pair<int32_t, int32_t> >(incidence_matrix[node_indices[0]].second[i], std::pair<int32_t, int32_t>(node_indices[0], node_indices[1])));
+		if (incidence_matrix[node_indices[1]].second[i] > 0)
+			edges_list.push_back(std::pair<T2, std::pair<int32_t, int32_t> >(incidence_matrix[node_indices[1]].second[i], std::pair<int32_t, int32_t>(node_indices[1], node_indices[0])));
 	}
+
+	csr_ = CSRGraph<T2>(numGraphNodes_, edges_list);
+	numGraphEdges_ = int32_t(csr_.NumEdges());
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::DFS(int64_t front_node_uuid, std::vector<std::pair<int64_t, int64_t> > &dfs_traversal_edge_list, std::map<int64_t, int32_t> &node_index_map, std::map<int64_t, int32_t> &node_num_map, int32_t &count)
+void Graph<T1, T2>::CreateNodeIndexTable()
 {
-	node_num_map[front_node_uuid] = ++count;
-	for (int32_t j = 0; j < adjacencyMatrix_.size(); j++)
-		if ((adjacencyMatrix_[node_index_map[front_node_uuid]].second[j] > 0 /* !=0 && !-ve*/) && (node_num_map[adjacencyMatrix_[j].first.uuid_] == 0))
-		{
-			dfs_traversal_edge_list.push_back(std::pair<int64_t, int64_t>(front_node_uuid, adjacencyMatrix_[j].first.uuid_));
-
-			DFS(adjacencyMatrix_[j].first.uuid_, dfs_traversal_edge_list, node_index_map, node_num_map, count);
-		}
+	std::vector<std::pair<int64_t, int32_t> > node_index_table;
+	node_index_table.reserve(numGraphNodes_);
+	for (int32_t i = 0; i < numGraphNodes_; i++)
+		node_index_table.push_back(std::pair<int64_t, int32_t>(nodes_[i].uuid_, i));
+	std::sort(node_index_table.begin(), node_index_table.end());
+
+	for (int32_t i = 1; i < numGraphNodes_; i++)
+		if (node_index_table[i].first == node_index_table[i - 1].first)
+			throw std::invalid_argument("ERROR: Duplicate node uuid " + std::to_string(node_index_table[i].first));
+	nodeIndexTable_ = MappedArray<std::pair<int64_t, int32_t> >(std::move(node_index_table));
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::FindCycles(std::vector<std::string> &cycle_terminal_vertices_list, int32_t flag)
+int32_t Graph<T1, T2>::GetNodeIndex(int64_t node_uuid) const
 {
-	cycle_terminal_vertices_list = {};
-
-	switch (flag)
-	{
-	case 0:
-		FindSimpleGraphCycles(cycle_terminal_vertices_list);
-		break;
-
-	case 1:
-		FindDigraphCycles(cycle_terminal_vertices_list);
-		break;
-
-	default:
-		break;
-	}
+	const std::pair<int64_t, int32_t> *it = std::lower_bound(nodeIndexTable_.begin(), nodeIndexTable_.end(), std::pair<int64_t, int32_t>(node_uuid, -1));
+	if ((it != nodeIndexTable_.end()) && (it->first == node_uuid))		return it->second;
 
+	std::map<int64_t, int32_t>::const_iterator pending_it = pendingNodeIndexTable_.find(node_uuid);
+	return (pending_it != pendingNodeIndexTable_.end()) ? pending_it->second : -1;
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::FindSimpleGraphCycles(std::vector<std::string> &cycle_terminal_vertices_list)
+int32_t Graph<T1, T2>::AddVertex(const Node<T1> &node)
 {
-	cycle_terminal_vertices_list = {};
-	
-	std::deque<int64_t> node_uuid_queue;
-	std::map<int64_t, int32_t> node_num_map;
-	std::map<int64_t, int32_t> node_index_map;
-	std::set<std::pair<int64_t, int64_t> > edge_list_set = {};
-	for (int32_t i = 0; i < adjacencyMatrix_.size(); i++)	{
-		node_num_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, 0));
-		node_index_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, i));
-		node_uuid_queue.push_back(adjacencyMatrix_[i].first.uuid_);
-	}
-
-	int32_t count = 0;
-	while (!CheckNodeNumQueueIsEmpty(node_uuid_queue, node_num_map)) {
-		int64_t front_node_uuid = node_uuid_queue.front();
-		node_uuid_queue.pop_front();
+	if (GetNodeIndex(node.uuid_) >= 0)
+		throw std::invalid_argument("ERROR: Duplicate node uuid " + std::to_string(node.uuid_));
 
-		GraphDepthCycle(front_node_uuid, cycle_terminal_vertices_list, node_index_map, node_num_map, edge_list_set, count);
-	}
+	int32_t node_index = NumNodes();
+	pendingNodes_.push_back(node);
+	pendingNodeIndexTable_[node.uuid_] = node_index;
+	return node_index;
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::GraphDepthCycle(int64_t front_node_uuid, std::vector<std::string> &cycle_terminal_vertices_list, std::map<int64_t, int32_t> &node_index_map, std::map<int64_t, int32_t> &node_num_map, std::set<std::pair<int64_t, int64_t> > &edge_list_set, int32_t &count)
+void Graph<T1, T2>::CheckEdgeVertices(int32_t start_vertex, int32_t end_vertex) const
 {
-	node_num_map[front_node_uuid] = ++count;
-	for (int32_t j = 0; j < adjacencyMatrix_.size(); j++)
-		if (adjacencyMatrix_[node_index_map[front_node_uuid]].second[j] > 0 /* !=0 && !-ve*/) {
-			if (node_num_map[adjacencyMatrix_[j].first.uuid_] == 0) {
-				edge_list_set.insert(std::pair<int64_t, int64_t>(front_node_uuid, adjacencyMatrix_[j].first.uuid_));
-				GraphDepthCycle(adjacencyMatrix_[j].first.uuid_, cycle_terminal_vertices_list, node_index_map, node_num_map, edge_list_set, count);
-			} 
-			else {
-				std::pair<int64_t, int64_t > edge= std::pair<int64_t, int64_t>(front_node_uuid, adjacencyMatrix_[j].first.uuid_);
-				if (edge_list_set.find(edge) == edge_list_set.end())
-				{
-					std::string cyclic_edge = std::to_string(front_node_uuid) + "-" + std::to_string(adjacencyMatrix_[j].first.uuid_);
-					cycle_terminal_vertices_list.push_back(cyclic_edge);
-				}
-			}
-		}
+	if ((start_vertex < 0) || (start_vertex >= NumNodes()) || (end_vertex < 0) || (end_vertex >= NumNodes()))
+		throw std::out_of_range("ERROR: Vertex index " + std::to_string(start_vertex) + " or " + std::to_string(end_vertex) + " is out of range");
 }
 
 
-
 template<typename T1, typename T2>
-void Graph<T1, T2>::FindDigraphCycles(std::vector<std::string> &cycle_terminal_vertices_list)
+bool Graph<T1, T2>::FindCurrentEdge(int32_t start_vertex, int32_t end_vertex, T2 &edge_weight) const
 {
-	std::vector<std::pair<int64_t, int64_t> > cycle_terminal_nodes_list = {};
-
-	std::deque<int64_t> node_uuid_queue;
-	std::map<int64_t, int32_t> node_num_map;
-	std::map<int64_t, int32_t> node_index_map;
-	for (int32_t i = 0; i < adjacencyMatrix_.size(); i++)	{
-		node_num_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, 0));
-		node_index_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, i));
-		node_uuid_queue.push_back(adjacencyMatrix_[i].first.uuid_);
-	}
-
-	int32_t count = 0;
-	while (!CheckNodeNumQueueIsEmpty(node_uuid_queue, node_num_map)) {
-		int64_t front_node_uuid = node_uuid_queue.front();
-		node_uuid_queue.pop_front();
-
-		DigraphDepthCycle(front_node_uuid, cycle_terminal_nodes_list, node_index_map, node_num_map, count);
-	}
-
-	for (const auto& elem : cycle_terminal_nodes_list) {
-		std::string terminal_nodes = "(" + std::to_string(elem.first) + "," + std::to_string(elem.second) + ")";
-		cycle_terminal_vertices_list.push_back(terminal_nodes);
+	typename std::map<std::pair<int32_t, int32_t>, std::pair<bool, T2> >::const_iterator it = pendingEdgeUpdates_.find(std::pair<int32_t, int32_t>(start_vertex, end_vertex));
+	if (it != pendingEdgeUpdates_.end()) {
+		edge_weight = it->second.second;
+		return it->second.first;
 	}
+	if ((start_vertex >= numGraphNodes_) || (end_vertex >= numGraphNodes_))		return false;
+	return csr_.FindEdge(start_vertex, end_vertex, edge_weight);
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::DigraphDepthCycle(int64_t front_node_uuid, std::vector<std::pair<int64_t, int64_t> > &cycle_terminal_nodes_list, std::map<int64_t, int32_t> &node_index_map, std::map<int64_t, int32_t> &node_num_map, int32_t &count)
+void Graph<T1, T2>::AddEdge(int32_t start_vertex_index, int32_t end_vertex_index, const T2 &edge_weight)
 {
-	node_num_map[front_node_uuid] = ++count;
-	for (int32_t j = 0; j < adjacencyMatrix_.size(); j++)
-		if (adjacencyMatrix_[node_index_map[front_node_uuid]].second[j] > 0 /* !=0 && !-ve*/) {
-			if (node_num_map[adjacencyMatrix_[j].first.uuid_] == 0) {
-				DigraphDepthCycle(adjacencyMatrix_[j].first.uuid_, cycle_terminal_nodes_list, node_index_map, node_num_map, count);
-			}
-			else if (node_num_map[adjacencyMatrix_[j].first.uuid_] != INFINITE_WEIGHT) {
-				cycle_terminal_nodes_list.push_back(std::pair<T1, T2>(front_node_uuid, adjacencyMatrix_[j].first.uuid_));
-			}
-		}
+	CheckEdgeVertices(start_vertex_index, end_vertex_index);
+	T2 current_weight;
+	if (FindCurrentEdge(start_vertex_index, end_vertex_index, current_weight))
+		throw std::invalid_argument("ERROR: Edge " + std::to_string(start_vertex_index) + " --> " + std::to_string(end_vertex_index) + " already exists, use UpdateWeight");
 
-	node_num_map[front_node_uuid] = INFINITE_WEIGHT;
+	pendingEdgeUpdates_[std::pair<int32_t, int32_t>(start_vertex_index, end_vertex_index)] = std::pair<bool, T2>(true, edge_weight);
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1,T2>::TopologicalSort(std::vector<std::string> &topological_sort_vertices_list)
+void Graph<T1, T2>::RemoveEdge(int32_t start_vertex_index, int32_t end_vertex_index)
 {
-	std::deque<int64_t> node_uuid_queue;
-	topological_sort_vertices_list = {};
-	std::map<int64_t, int32_t> node_num_map;
-	std::map<int64_t, int32_t> node_index_map;
-	std::map<int64_t, int32_t> ts_node_num_map;
-
-	for (int32_t i = 0; i < adjacencyMatrix_.size(); i++)	{
-		node_num_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, 0));
-		ts_node_num_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, 0));
-		node_index_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, i));
-		node_uuid_queue.push_back(adjacencyMatrix_[i].first.uuid_);
-	}
-
-	int32_t dfs_count = 0;
-	int32_t ts_count = 0;
-	bool TS_CYCLE_ABSENT_COND = true;
-	while ( (!CheckNodeNumQueueIsEmpty(node_uuid_queue, node_num_map)) && (TS_CYCLE_ABSENT_COND) ) {
-		int64_t front_node_uuid = node_uuid_queue.front();
-		node_uuid_queue.pop_front();
-
-		TSort(front_node_uuid, node_index_map, node_num_map, ts_node_num_map, dfs_count, ts_count, TS_CYCLE_ABSENT_COND);
-	}
-
-	if (TS_CYCLE_ABSENT_COND) {
-		std::vector<std::pair<int32_t, int64_t> > ts_node_num_map_vector;
-		for (const auto &elem : ts_node_num_map)	
-			ts_node_num_map_vector.push_back(std::pair<int32_t, int64_t>(elem.second, elem.first));
-		std::sort(ts_node_num_map_vector.begin(), ts_node_num_map_vector.end());
-
-		for (const auto& elem : ts_node_num_map_vector)	topological_sort_vertices_list.push_back(std::to_string(elem.second));
-	}
-}
+	CheckEdgeVertices(start_vertex_index, end_vertex_index);
+	T2 current_weight;
+	if (!FindCurrentEdge(start_vertex_index, end_vertex_index, current_weight))
+		throw std::invalid_argument("ERROR: There is no edge " + std::to_string(start_vertex_index) + " --> " + std::to_string(end_vertex_index));
 
-
-template<typename T1, typename T2>
-void Graph<T1, T2>::TSort(int64_t front_node_uuid, std::map<int64_t, int32_t> &node_index_map, std::map<int64_t, int32_t> &node_num_map, std::map<int64_t, int32_t> &ts_node_num_map, int32_t &dfs_count, int32_t &ts_count, bool &TS_CYCLE_ABSENT_COND)
-{
-	node_num_map[front_node_uuid] = ++dfs_count;
-	for (int32_t j = 0; j < adjacencyMatrix_.size(); j++)
-		if (adjacencyMatrix_[node_index_map[front_node_uuid]].second[j] > 0 /* !=0 && !-ve*/) {
-			if (node_num_map[adjacencyMatrix_[j].first.uuid_] == 0)
-				TSort(adjacencyMatrix_[j].first.uuid_, node_index_map, node_num_map, ts_node_num_map, dfs_count, ts_count, TS_CYCLE_ABSENT_COND);
-			else if (ts_node_num_map[adjacencyMatrix_[j].first.uuid_] == 0) {
-				TS_CYCLE_ABSENT_COND = false;
-				// std::string error_str = "Cycle detected in the Graph: Topological Sort Not Possible";
-				// throw std::exception(error_str.c_str());
-			}
-		}
-	ts_node_num_map[front_node_uuid] = ++ts_count;
+	pendingEdgeUpdates_[std::pair<int32_t, int32_t>(start_vertex_index, end_vertex_index)] = std::pair<bool, T2>(false, T2(0));
 }
 
 
 template<typename T1, typename T2>
-bool Graph<T1, T2>::CheckNodeNumQueueIsEmpty(std::deque<int64_t> &node_uuid_queue, std::map<int64_t, int32_t> &node_num_map)
+void Graph<T1, T2>::UpdateWeight(int32_t start_vertex_index, int32_t end_vertex_index, const T2 &edge_weight)
 {
-	for (int32_t i = 0; i < node_uuid_queue.size(); i++)
-		if (node_num_map[node_uuid_queue[i]] != 0)	{
-			node_uuid_queue.erase(node_uuid_queue.begin() + i);
-			i--;
-		}
+	CheckEdgeVertices(start_vertex_index, end_vertex_index);
+	T2 current_weight;
+	if (!FindCurrentEdge(start_vertex_index, end_vertex_index, current_weight))
+		throw std::invalid_argument("ERROR: There is no edge " + std::to_string(start_vertex_index) + " --> " + std::to_string(end_vertex_index));
 
-	if (node_uuid_queue.empty())	return true;
-	return false;
+	pendingEdgeUpdates_[std::pair<int32_t, int32_t>(start_vertex_index, end_vertex_index)] = std::pair<bool, T2>(true, edge_weight);
 }
 
 
+// Every out-edge list is rebuilt as its committed edges without the updated ones, followed by the updated edges that are
+// still present. The updates are sorted by (u, v), so one sweep over the vertices visits them in order
 template<typename T1, typename T2>
-void Graph<T1, T2>::ShortestPathAlgorithm(std::vector<std::string> &shortest_path, int32_t flag, int32_t start_vertex_index)
+void Graph<T1, T2>::CommitUpdates()
 {
-	shortest_path = {};
-
-	switch (flag)
-	{
-	case 0:
-		DijkstraShortestPathAlgorithm(shortest_path, start_vertex_index);
-		break;
-
-	case 1:
-		FordAlgorithm(shortest_path, start_vertex_index);
-		break;
+	if (NumPendingUpdates() == 0)		return;
 
-	case 2:
-		GenericLabelCorrectingAlgorithm(shortest_path, start_vertex_index);
-		break;
+	int32_t num_nodes = NumNodes();
+	if (!pendingNodes_.empty()) {
+		std::vector<Node<T1> > nodes(nodes_.begin(), nodes_.end());
+		nodes.insert(nodes.end(), pendingNodes_.begin(), pendingNodes_.end());
+		nodes_ = MappedArray<Node<T1> >(std::move(nodes));
+	}
 
-	default:
-		// All to All Shortest Path Algorithm
-		WFIAlgorithm(shortest_path);
-		break;
+	std::vector<int64_t> offsets(num_nodes + 1, 0);
+	std::vector<int32_t> neighbors;
+	std::vector<T2> weights;
+	neighbors.reserve(csr_.NumEdges() + pendingEdgeUpdates_.size());
+	weights.reserve(csr_.NumEdges() + pendingEdgeUpdates_.size());
+
+	typename std::map<std::pair<int32_t, int32_t>, std::pair<bool, T2> >::const_iterator update_it = pendingEdgeUpdates_.begin();
+	for (int32_t u = 0; u < num_nodes; u++) {
+		typename std::map<std::pair<int32_t, int32_t>, std::pair<bool, T2> >::const_iterator update_begin = update_it;
+		while ((update_it != pendingEdgeUpdates_.end()) && (update_it->first.first == u))		++update_it;
+
+		if (u < numGraphNodes_)
+			for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++)
+				if ((update_begin == update_it) || (pendingEdgeUpdates_.find(std::pair<int32_t, int32_t>(u, csr_.Neighbor(e))) == pendingEdgeUpdates_.end())) {
+					neighbors.push_back(csr_.Neighbor(e));
+					weights.push_back(csr_.Weight(e));
+				}
+		for (typename std::map<std::pair<int32_t, int32_t>, std::pair<bool, T2> >::const_iterator it = update_begin; it != update_it; ++it)
+			if (it->second.first) {
+				neighbors.push_back(it->first.second);
+				weights.push_back(it->second.second);
+			}
+		offsets[u + 1] = neighbors.size();
 	}
+
+	csr_ = CSRGraph<T2>(std::move(offsets), std::move(neighbors), std::move(weights));
+	reverseCsr_ = csr_.Transpose();
+	numGraphNodes_ = num_nodes;
+	numGraphEdges_ = int32_t(csr_.NumEdges());
+	if (!pendingNodes_.empty())		CreateNodeIndexTable();
+
+	pendingNodes_.clear();
+	pendingNodeIndexTable_.clear();
+	pendingEdgeUpdates_.clear();
+
+	landmarkList_.clear();
+	landmarkFromDistances_.clear();
+	landmarkToDistances_.clear();
+	contractionHierarchy_.Clear();
+	negativeWeightState_ = -1;
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::GenerateLabelAndNodeMap(std::map<int64_t, std::pair<T2, int64_t> > &label_map, int32_t start_vertex_index, std::map<int64_t, int32_t> &node_index_map)
+T2 Graph<T1, T2>::GetAdjacencyMatrixEntry(int32_t row_index, int32_t column_index)
 {
-	for (const auto &elem : adjacencyMatrix_) {
-		T2 currDist = (elem.first.uuid_ == adjacencyMatrix_[start_vertex_index].first.uuid_) ? T2(0) : T2(INFINITE_WEIGHT);
-		label_map.insert(std::pair<int64_t, std::pair<T2, int64_t> >(elem.first.uuid_, std::pair<T2, int64_t>(currDist, adjacencyMatrix_[start_vertex_index].first.uuid_)));
-	}
-
-	for (int32_t i = 0; i < adjacencyMatrix_.size(); i++)	{
-		node_index_map.insert(std::pair<int64_t, int32_t>(adjacencyMatrix_[i].first.uuid_, i));
-	}
+	// +ve weight for an edge row-->column, -ve weight for an edge column-->row (Convention above)
+	T2 edge_weight = T2(0);
+	if (csr_.FindEdge(row_index, column_index, edge_weight))		return edge_weight;
+	if (reverseCsr_.FindEdge(row_index, column_index, edge_weight))		return T2(-1) * edge_weight;
+	return T2(0);
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::GenerateShortestPathFromLabelMap(std::map<int64_t, std::pair<T2, int64_t> > &label_map, std::vector<std::string> &shortest_path)
+void Graph<T1, T2>::DisplayAdjacencyMatrix()
 {
-	for (const auto& elem : adjacencyMatrix_) {
-		std::string elem_details = std::to_string(elem.first.uuid_) + "  -->  " + 
-			                       std::to_string(label_map[elem.first.uuid_].first) + "     " +
-								   std::to_string(label_map[elem.first.uuid_].second) + "\n";
-		shortest_path.push_back(elem_details);
+	CommitUpdates();
+	std::cout << std::endl << "\t";
+	for (const auto& elem : nodes_)		std::cout << elem.uuid_ << "\t";
+	
+	for (int32_t i = 0; i < numGraphNodes_; i++) {
+		std::cout << std::endl << nodes_[i].uuid_ << "\t";
+		for (int32_t j = 0; j < numGraphNodes_; j++)		std::cout << GetAdjacencyMatrixEntry(i, j) << "\t";
 	}
+
+	std::cout << "\n\n";
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::DijkstraShortestPathAlgorithm(std::vector<std::string> &shortest_path, int32_t start_vertex_index)
+void Graph<T1, T2>::DisplayIncidenceMatrix()
 {
-	std::map<int64_t, std::pair<T2, int64_t> > label_map;	// Node_ID --> Current Distance, Predecessor_Node_ID
-	std::map<int64_t, int32_t> node_index_map;		// Node_ID --> Number of Node in the Adjacency Matrix
-	GenerateLabelAndNodeMap(label_map, start_vertex_index, node_index_map);
-	
-	std::set<int64_t> node_uuid_set;
-	for (const auto &elem : adjacencyMatrix_)	 node_uuid_set.insert(elem.first.uuid_);
-	
-	int32_t count = 0;
-	while (!node_uuid_set.empty())
-	{
-		int64_t minimal_curr_dist_node_id = GetMinimalCurrentDistanceNodeID(label_map, node_uuid_set);
-		node_uuid_set.erase(minimal_curr_dist_node_id);
-
-		for (int32_t j = 0; j < adjacencyMatrix_.size(); j++)
-			if (adjacencyMatrix_[node_index_map[minimal_curr_dist_node_id]].second[j] > 0 /* !=0 && !-ve*/) {
-				if (label_map[adjacencyMatrix_[j].first.uuid_].first > label_map[minimal_curr_dist_node_id].first + adjacencyMatrix_[node_index_map[minimal_curr_dist_node_id]].second[j]) {
-					label_map[adjacencyMatrix_[j].first.uuid_].first = label_map[minimal_curr_dist_node_id].first + adjacencyMatrix_[node_index_map[minimal_curr_dist_node_id]].second[j];
-					label_map[adjacencyMatrix_[j].first.uuid_].second = minimal_curr_dist_node_id;
-				}
-			}
+	CommitUpdates();
+	// Every pair of connected nodes (i < j) is one column of the Incidence Matrix
+	std::vector<std::pair<int32_t, int32_t> > incidence_edges_list;
+	for (int32_t i = 0; i < numGraphNodes_; i++) {
+		for (int64_t e = csr_.EdgeBegin(i); e < csr_.EdgeEnd(i); e++)
+			if (csr_.Neighbor(e) > i)		incidence_edges_list.push_back(std::pair<int32_t, int32_t>(i, csr_.Neighbor(e)));
+		for (int64_t e = reverseCsr_.EdgeBegin(i); e < reverseCsr_.EdgeEnd(i); e++)
+			if (reverseCsr_.Neighbor(e) > i)		incidence_edges_list.push_back(std::pair<int32_t, int32_t>(i, reverseCsr_.Neighbor(e)));
+	}
+	std::sort(incidence_edges_list.begin(), incidence_edges_list.end());
+	incidence_edges_list.erase(std::unique(incidence_edges_list.begin(), incidence_edges_list.end()), incidence_edges_list.end());
 
-		++count;
+	std::cout << std::endl << "\t";
+	for (const auto& elem : incidence_edges_list)
+		std::cout << nodes_[elem.first].uuid_ << "-" << nodes_[elem.second].uuid_ << "\t";
 
-		// Print this if you want to see the change in shortest path distances in all iterations
-		std::string path_iter_str = "";
-		for (int32_t i = 0; i < adjacencyMatrix_.size(); i++)	{
-			path_iter_str += "(" + std::to_string(adjacencyMatrix_[i].first.uuid_) +
-							 "->" + std::to_string(label_map[adjacencyMatrix_[i].first.uuid_].first) +
-							 "," + std::to_string(label_map[adjacencyMatrix_[i].first.uuid_].second) + ")";
-			path_iter_str += (i == adjacencyMatrix_.size() - 1) ? "" : ";";
+	for (int32_t i = 0; i < numGraphNodes_; i++) {
+		std::cout << std::endl << nodes_[i].uuid_ << "\t";
+		for (const auto& elem : incidence_edges_list) {
+			if (elem.first == i)			std::cout << GetAdjacencyMatrixEntry(i, elem.second) << "\t";
+			else if (elem.second == i)		std::cout << GetAdjacencyMatrixEntry(i, elem.first) << "\t";
+			else std::cout << T2(0) << "\t";
 		}
-		std::cout << "\nIteration " << count << ": [" << path_iter_str << "]";
 	}
 
-	std::string iterations = "\nNumber of Iterations = " + std::to_string(count) + "\n";
-	shortest_path.push_back(iterations);
-	GenerateShortestPathFromLabelMap(label_map, shortest_path);
+	std::cout << "\n\n";
 }
 
 
 template<typename T1, typename T2>
-int64_t Graph<T1, T2>::GetMinimalCurrentDistanceNodeID(std::map<int64_t, std::pair<T2, int64_t> > &label_map, std::set<int64_t> &node_uuid_set)
+void Graph<T1, T2>::BreadthFirstSearch(std::vector<std::string> &bfs_traversal_edge_list)
 {
-	int64_t min_dist_node_id;
-	T2 min_dist;
-
-	bool CONTINUE_LOOP_COND = true;
-	int32_t match_index;
-	for (int32_t i = 0; (i<adjacencyMatrix_.size()) && (CONTINUE_LOOP_COND); i++)
-		if (node_uuid_set.count(adjacencyMatrix_[i].first.uuid_) > 0) {
-			CONTINUE_LOOP_COND = false;
-			min_dist_node_id = adjacencyMatrix_[i].first.uuid_;
-			min_dist = label_map[adjacencyMatrix_[i].first.uuid_].first;
-			match_index = i;
-		}	
-
-	for (int32_t i = 0; (i < adjacencyMatrix_.size()) && (i != match_index) && (node_uuid_set.count(adjacencyMatrix_[i].first.uuid_) > 0); i++) {
-		if (min_dist > label_map[adjacencyMatrix_[i].first.uuid_].first) {
-			min_dist_node_id = adjacencyMatrix_[i].first.uuid_;
-			min_dist = label_map[adjacencyMatrix_[i].first.uuid_].first;
-		}
-	}
+	CommitUpdates();
+	bfs_traversal_edge_list = {};
+	if (numGraphNodes_ == 0)	return;
 
-	return min_dist_node_id;
+	TraversalResult result;
+	BreadthFirstSearch(result, 0);
+	GraphPrinter<T1, T2>::WriteTraversalEdges(*this, result, bfs_traversal_edge_list);
 }
 
 
+// Direction-Optimizing BFS (Beamer, Asanovic and Patterson). Every level is expanded either
+//   top-down:  the vertices of the frontier queue scan their out-edges for unvisited vertices, or
+//   bottom-up: every unvisited vertex scans its in-edges for a parent in the frontier bitmap and stops at the first one found
+// Top-down switches to bottom-up when the edges out of the frontier (m_f) exceed the edges to check from the unvisited
+// vertices (m_u) divided by alpha, and back when the frontier holds less than n / beta vertices.
 template<typename T1, typename T2>
-void Graph<T1, T2>::FordAlgorithm(std::vector<std::string> &shortest_path, int32_t start_vertex_index)
+void Graph<T1, T2>::BreadthFirstSearch(TraversalResult &result, int32_t start_vertex_index)
 {
-	std::map<int64_t, std::pair<T2, int64_t> > current_label_map, previous_label_map;	// Node_ID --> Current Distance, Predecessor_Node_ID
-	std::map<int64_t, int32_t> node_index_map;		// Node_ID --> Number of Node in the Adjacency Matrix
-	GenerateLabelAndNodeMap(current_label_map, start_vertex_index, node_index_map);
-    
-	std::vector<std::pair<std::pair<int64_t, int64_t>, T2> > edge_node_uuids_dist_map;
-	for (int32_t i = 0; i < adjacencyMatrix_.size(); i++) {
-		for (int32_t j = 0; j < adjacencyMatrix_[i].second.size(); j++) {
-			if (adjacencyMatrix_[i].second[j] > 0)
-				edge_node_uuids_dist_map.push_back(std::pair<std::pair<int64_t, int64_t>, T2>(std::pair<int64_t, int64_t>(adjacencyMatrix_[i].first.uuid_, adjacencyMatrix_[j].first.uuid_), adjacencyMatrix_[i].second[j]));
+	CommitUpdates();
+	if ((start_vertex_index < 0) || (start_vertex_index >= numGraphNodes_))
+		throw std::out_of_range("ERROR: Start vertex index " + std::to_string(start_vertex_index) + " is out of range");
+
+	std::vector<int32_t> &parent_list = result.parents_, &level_list = result.levels_;
+	result.sourceVertex_ = start_vertex_index;
+	parent_list.assign(numGraphNodes_, -1);
+	level_list.assign(numGraphNodes_, -1);
+	result.order_.assign(1, start_vertex_index);
+	result.order_.reserve(numGraphNodes_);
+	parent_list[start_vertex_index] = start_vertex_index;
+	level_list[start_vertex_index] = 0;
+
+	int32_t num_bitmap_words = (numGraphNodes_ + 63) / 64;
+	std::vector<uint64_t> frontier_bitmap(num_bitmap_words, 0), next_frontier_bitmap(num_bitmap_words, 0);
+	std::vector<int32_t> frontier(1, start_vertex_index), next_frontier;
+
+	int64_t num_frontier_edges = csr_.OutDegree(start_vertex_index);					// m_f
+	int64_t num_unvisited_edges = csr_.NumEdges() - num_frontier_edges;		// m_u
+	int64_t num_frontier_nodes = 1;														// n_f
+	bool BOTTOM_UP_COND = false;
+
+	for (int32_t level = 0; num_frontier_nodes > 0; level++) {
+		if ((!BOTTOM_UP_COND) && (num_frontier_edges > num_unvisited_edges / BFS_TOP_DOWN_ALPHA)) {
+			BOTTOM_UP_COND = true;
+			std::fill(frontier_bitmap.begin(), frontier_bitmap.end(), 0);
+			for (const auto &elem : frontier)		frontier_bitmap[elem >> 6] |= uint64_t(1) << (elem & 63);
+		}
+		else if ((BOTTOM_UP_COND) && (num_frontier_nodes < numGraphNodes_ / BFS_BOTTOM_UP_BETA)) {
+			BOTTOM_UP_COND = false;
+			frontier.clear();
+			for (int32_t v = 0; v < numGraphNodes_; v++)
+				if ((frontier_bitmap[v >> 6] >> (v & 63)) & 1)		frontier.push_back(v);
 		}
-	}
-
-	bool CONTINUE_EXHAUSTIVE_FORD_ALGO_COND = true;
-	int64_t iteration_count = 0;
-
-	while (CONTINUE_EXHAUSTIVE_FORD_ALGO_COND) {
 
-		for (const auto &elem : edge_node_uuids_dist_map)
-			if (current_label_map[elem.first.second].first > current_label_map[elem.first.first].first + elem.second) {
-				current_label_map[elem.first.second].first = current_label_map[elem.first.first].first + elem.second;
-				current_label_map[elem.first.second].second = elem.first.first;
+		num_frontier_edges = 0;
+		num_frontier_nodes = 0;
+		if (!BOTTOM_UP_COND) {
+			next_frontier.clear();
+			for (const auto &u : frontier)
+				for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++) {
+					int32_t v = csr_.Neighbor(e);
+					if (parent_list[v] == -1) {
+						parent_list[v] = u;
+						level_list[v] = level + 1;
+						next_frontier.push_back(v);
+						result.order_.push_back(v);
+						num_frontier_edges += csr_.OutDegree(v);
+					}
+				}
+			frontier.swap(next_frontier);
+			num_frontier_nodes = frontier.size();
+		}
+		else {
+			std::fill(next_frontier_bitmap.begin(), next_frontier_bitmap.end(), 0);
+			for (int32_t v = 0; v < numGraphNodes_; v++) {
+				if (parent_list[v] != -1)		continue;
+				for (int64_t e = reverseCsr_.EdgeBegin(v); e < reverseCsr_.EdgeEnd(v); e++) {
+					int32_t u = reverseCsr_.Neighbor(e);
+					if ((frontier_bitmap[u >> 6] >> (u & 63)) & 1) {
+						parent_list[v] = u;
+						level_list[v] = level + 1;
+						next_frontier_bitmap[v >> 6] |= uint64_t(1) << (v & 63);
+						result.order_.push_back(v);
+						num_frontier_edges += csr_.OutDegree(v);
+						++num_frontier_nodes;
+						break;
+					}
+				}
 			}
-
-		++iteration_count;
-		if (iteration_count > 1) {
-			bool EXACT_MATCH_COND = true;
-			for (const auto& elem : adjacencyMatrix_)
-				EXACT_MATCH_COND = EXACT_MATCH_COND && (previous_label_map[elem.first.uuid_].first == current_label_map[elem.first.uuid_].first);
-			CONTINUE_EXHAUSTIVE_FORD_ALGO_COND = !EXACT_MATCH_COND;
+			frontier_bitmap.swap(next_frontier_bitmap);
 		}
-		previous_label_map = current_label_map;
 
-		// Print this if you want to see the change in shortest path distances in all iterations
-		std::string path_iter_str = "";
-		for (int32_t i = 0; i < adjacencyMatrix_.size(); i++)	{
-			path_iter_str += "(" + std::to_string(adjacencyMatrix_[i].first.uuid_) +
-							 "->" + std::to_string(current_label_map[adjacencyMatrix_[i].first.uuid_].first) +
-							 "," + std::to_string(current_label_map[adjacencyMatrix_[i].first.uuid_].second) + ")";
-			path_iter_str += (i == adjacencyMatrix_.size() - 1) ? "" : ";";
-		}
-		std::cout << "\nIteration " << iteration_count << ": [" << path_iter_str << "]";
+		num_unvisited_edges -= num_frontier_edges;
 	}
-	
-	std::string iterations = "\nNumber of Iterations = " + std::to_string(iteration_count) + "\n";
-	shortest_path.push_back(iterations);
-	
-	GenerateShortestPathFromLabelMap(current_label_map, shortest_path);
 }
 
 
+// Level-synchronous parallel BFS on numThreads_ threads. The vertices of the current frontier are expanded concurrently; a vertex is
+// claimed by the first thread that sets its bit in the visited bitmap with an atomic compare-and-swap, so every vertex enters the
+// next frontier exactly once. Every thread appends the vertices it claims to its own buffer and the buffers are concatenated into
+// the next frontier after the level. The levels are identical to the sequential BFS; the parent of a vertex can be any vertex of
+// the previous level that has an edge to it, depending on which thread claims it first
 template<typename T1, typename T2>
-void Graph<T1, T2>::GenericLabelCorrectingAlgorithm(std::vector<std::string> &shortest_path, int32_t start_vertex_index)
+void Graph<T1, T2>::ParallelBreadthFirstSearch(TraversalResult &result, int32_t start_vertex_index)
 {
-	std::map<int64_t, std::pair<T2, int64_t> > label_map;	// Node_ID --> Current Distance, Predecessor_Node_ID
-	std::map<int64_t, int32_t> node_index_map;		// Node_ID --> Number of Node in the Adjacency Matrix
-	GenerateLabelAndNodeMap(label_map, start_vertex_index, node_index_map);
-
-	std::map<int64_t, int32_t> node_uuid_frequency;
-	for (const auto &elem : adjacencyMatrix_)	node_uuid_frequency.insert(std::pair<int64_t, int32_t>(elem.first.uuid_, 0));
-	
-	std::deque<int64_t> node_uuid_queue;
-	node_uuid_queue.push_back(adjacencyMatrix_[start_vertex_index].first.uuid_);
-	node_uuid_frequency[adjacencyMatrix_[start_vertex_index].first.uuid_] += 1;
-
-	int32_t count = 0;
-	while (!node_uuid_queue.empty())
-	{
-		int64_t minimal_curr_dist_node_id = node_uuid_queue.front();
-		node_uuid_queue.pop_front();
-
-		bool FOUND_ELEM_COND = false;
-		for (int32_t j = 0; j < adjacencyMatrix_.size(); j++)
-		if (adjacencyMatrix_[node_index_map[minimal_curr_dist_node_id]].second[j] > 0 /* !=0 && !-ve*/) {
-			if (label_map[adjacencyMatrix_[j].first.uuid_].first > label_map[minimal_curr_dist_node_id].first + adjacencyMatrix_[node_index_map[minimal_curr_dist_node_id]].second[j]) {
-				label_map[adjacencyMatrix_[j].first.uuid_].first = label_map[minimal_curr_dist_node_id].first + adjacencyMatrix_[node_index_map[minimal_curr_dist_node_id]].second[j];
-				label_map[adjacencyMatrix_[j].first.uuid_].second = minimal_curr_dist_node_id;
-				
-				FOUND_ELEM_COND = false;
-				for (const auto & elem: node_uuid_queue)
-					if (elem == adjacencyMatrix_[j].first.uuid_) {
-						FOUND_ELEM_COND = true;
+	CommitUpdates();
+	if ((start_vertex_index < 0) || (start_vertex_index >= numGraphNodes_))
+		throw std::out_of_range("ERROR: Start vertex index " + std::to_string(start_vertex_index) + " is out of range");
+
+	std::vector<int32_t> &parent_list = result.parents_, &level_list = result.levels_;
+	result.sourceVertex_ = start_vertex_index;
+	parent_list.assign(numGraphNodes_, -1);
+	level_list.assign(numGraphNodes_, -1);
+	result.order_.assign(1, start_vertex_index);
+	parent_list[start_vertex_index] = start_vertex_index;
+	level_list[start_vertex_index] = 0;
+
+	std::vector<std::atomic<uint64_t> > visited_bitmap((numGraphNodes_ + 63) / 64);
+	for (auto &elem : visited_bitmap)		elem.store(0, std::memory_order_relaxed);
+	visited_bitmap[start_vertex_index >> 6].store(uint64_t(1) << (start_vertex_index & 63), std::memory_order_relaxed);
+
+	ThreadPool &thread_pool = GetThreadPool();
+	std::vector<std::vector<int32_t> > local_frontier_lists(thread_pool.NumThreads());
+	std::vector<int32_t> frontier(1, start_vertex_index), next_frontier;
+	int32_t level = 0;
+
+	std::function<void(int64_t, int64_t, int32_t)> expand_frontier = [&](int64_t begin_index, int64_t end_index, int32_t thread_id) {
+		std::vector<int32_t> &local_frontier = local_frontier_lists[thread_id];
+		for (int64_t i = begin_index; i < end_index; i++) {
+			int32_t u = frontier[i];
+			for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++) {
+				int32_t v = csr_.Neighbor(e);
+				uint64_t bit = uint64_t(1) << (v & 63);
+				std::atomic<uint64_t> &word = visited_bitmap[v >> 6];
+				uint64_t word_value = word.load(std::memory_order_relaxed);
+				bool CLAIMED_COND = false;
+				while ((word_value & bit) == 0)
+					if (word.compare_exchange_weak(word_value, word_value | bit, std::memory_order_relaxed)) {
+						CLAIMED_COND = true;
 						break;
 					}
-				
-				if (!FOUND_ELEM_COND)	{
-					node_uuid_frequency[adjacencyMatrix_[j].first.uuid_] += 1;
-					std::deque<int64_t>::iterator it = node_uuid_queue.begin();
-					for (; it != node_uuid_queue.end(); ++it)
-						if (node_uuid_frequency[*it] < node_uuid_frequency[adjacencyMatrix_[j].first.uuid_]) 
-							break;
-					node_uuid_queue.insert(it, adjacencyMatrix_[j].first.uuid_);
+
+				if (CLAIMED_COND) {
+					parent_list[v] = u;
+					level_list[v] = level + 1;
+					local_frontier.push_back(v);
 				}
 			}
 		}
-
-		++count;
-
-		// Print this if you want to see the change in shortest path distances in all iterations
-		std::string path_iter_str = "";
-		for (int32_t i = 0; i < adjacencyMatrix_.size(); i++)	{
-			path_iter_str += "(" + std::to_string(adjacencyMatrix_[i].first.uuid_) +
-				"->" + std::to_string(label_map[adjacencyMatrix_[i].first.uuid_].first) +
-				"," + std::to_string(label_map[adjacencyMatrix_[i].first.uuid_].second) + ")";
-			path_iter_str += (i == adjacencyMatrix_.size() - 1) ? "" : ";";
-		}
-		std::cout << "\nIteration " << count << ": [" << path_iter_str << "]";
+	};
+
+	std::vector<size_t> frontier_offsets(thread_pool.NumThreads() + 1);
+	std::function<void(int32_t)> gather_frontier = [&](int32_t thread_id) {
+		std::copy(local_frontier_lists[thread_id].begin(), local_frontier_lists[thread_id].end(), next_frontier.begin() + frontier_offsets[thread_id]);
+		local_frontier_lists[thread_id].clear();
+	};
+
+	while (!frontier.empty()) {
+		thread_pool.ParallelFor(0, frontier.size(), expand_frontier, 64);
+
+		frontier_offsets[0] = 0;
+		for (int32_t t = 0; t < thread_pool.NumThreads(); t++)
+			frontier_offsets[t + 1] = frontier_offsets[t] + local_frontier_lists[t].size();
+		next_frontier.resize(frontier_offsets.back());
+		thread_pool.Run(gather_frontier);
+		result.order_.insert(result.order_.end(), next_frontier.begin(), next_frontier.end());
+
+		frontier.swap(next_frontier);
+		++level;
 	}
-
-	std::string iterations = "\nNumber of Iterations = " + std::to_string(count) + "\n";
-	shortest_path.push_back(iterations);
-	GenerateShortestPathFromLabelMap(label_map, shortest_path);
 }
 
 
+// The DFS family below runs on the iterative DFSEngine: every algorithm is a visitor that handles only the events it needs
 template<typename T1, typename T2>
-void Graph<T1, T2>::WFIAlgorithm(std::vector<std::string> &shortest_path)
+void Graph<T1, T2>::DepthFirstSearch(std::vector<std::pair<int64_t, int64_t> > &dfs_traversal_edge_list)
 {
-	std::vector<std::pair<int32_t, std::vector<T2> > > weight_matrix;
+	CommitUpdates();
+	dfs_traversal_edge_list = {};
 
-	for (int32_t i = 0; i < adjacencyMatrix_.size(); i++) {
-		std::vector<T2> row_weights;
-		for (int32_t j = 0; j < adjacencyMatrix_[i].second.size(); j++)
-			if (i == j)	row_weights.push_back(T2(0));
-			else if (adjacencyMatrix_[i].second[j] > 0)		row_weights.push_back(adjacencyMatrix_[i].second[j]);
-			else row_weights.push_back(T2(INFINITE_WEIGHT));
-		weight_matrix.push_back(std::pair<int32_t, std::vector<T2> >(i, row_weights));
-	}
+	TraversalResult result;
+	DepthFirstSearch(result);
+	for (const auto &v : result.order_)
+		if (result.parents_[v] != v)
+			dfs_traversal_edge_list.push_back(std::pair<int64_t, int64_t>(nodes_[result.parents_[v]].uuid_, nodes_[v].uuid_));
+}
 
-	for (int32_t i = 0; i < adjacencyMatrix_.size(); i++)	
-		for (int32_t j = 0; j < adjacencyMatrix_.size(); j++)	
-			for (int32_t k = 0; k < adjacencyMatrix_.size(); k++)	
-				if (weight_matrix[j].second[k] > weight_matrix[j].second[i] + weight_matrix[i].second[k])
-					weight_matrix[j].second[k] = weight_matrix[j].second[i] + weight_matrix[i].second[k];
-	
-	// Writing the matrix for the All-To-All Shortest Path
-	std::string nodes_info_str = "\t";
-	for (const auto& elem : adjacencyMatrix_)	nodes_info_str += std::to_string(elem.first.uuid_) + "\t";
-	shortest_path.push_back(nodes_info_str + "\n");
 
-	for (const auto& elem : weight_matrix) {
-		nodes_info_str = std::to_string(adjacencyMatrix_[elem.first].first.uuid_) + "\t";
-		for (const auto & elem2 : elem.second)
-			nodes_info_str += std::to_string(elem2) + "\t";
-		nodes_info_str += "\n";
-		shortest_path.push_back(nodes_info_str);
-	}
+// DFS forest over all the vertices, a new tree is started from every vertex left undiscovered in increasing index order
+template<typename T1, typename T2>
+void Graph<T1, T2>::DepthFirstSearch(TraversalResult &result)
+{
+	CommitUpdates();
+	result.sourceVertex_ = -1;
+	result.parents_.assign(numGraphNodes_, -1);
+	result.levels_.assign(numGraphNodes_, -1);
+	result.order_.clear();
+	result.order_.reserve(numGraphNodes_);
+
+	DFSEngine<T2> dfs_engine(csr_);
+	struct TraversalVisitor : public DFSVisitor {
+		const DFSEngine<T2> &dfsEngine_;
+		TraversalResult &result_;
+
+		TraversalVisitor(const DFSEngine<T2> &dfs_engine, TraversalResult &result) : dfsEngine_(dfs_engine), result_(result) { }
+		void DiscoverVertex(int32_t vertex) {
+			int32_t parent = dfsEngine_.Parent(vertex);
+			result_.parents_[vertex] = (parent == -1) ? vertex : parent;
+			result_.levels_[vertex] = (parent == -1) ? 0 : result_.levels_[parent] + 1;
+			result_.order_.push_back(vertex);
+		}
+	} visitor(dfs_engine, result);
+
+	dfs_engine.VisitAll(visitor);
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::MinimumSpanningTree(std::vector<std::string> &mst_adjacency_matrix, int32_t flag)
+void Graph<T1, T2>::FindCycles(std::vector<std::string> &cycle_terminal_vertices_list, int32_t flag)
 {
-	mst_adjacency_matrix = {};
+	CommitUpdates();
+	cycle_terminal_vertices_list = {};
 
 	switch (flag)
 	{
 	case 0:
-		KruskalAlgorithm(mst_adjacency_matrix);
+		FindSimpleGraphCycles(cycle_terminal_vertices_list);
 		break;
 
 	case 1:
-		DijkstraMSTAlgorithm(mst_adjacency_matrix);
+		FindDigraphCycles(cycle_terminal_vertices_list);
+		break;
+
+	case 2:
+		FindDigraphCycleComponents(cycle_terminal_vertices_list);
 		break;
 
 	default:
 		break;
 	}
+
 }
 
 
+// Every edge u-->v of an undirected Graph is stored in both directions, so every back edge u-->v closes a cycle except the first
+// copy of the tree edge v-->u seen backwards from u (a parallel edge to the DFS parent still closes a cycle). The back edge u-->v
+// is seen again from v as a forward edge, which is not reported twice
 template<typename T1, typename T2>
-void Graph<T1, T2>::KruskalAlgorithm(std::vector<std::string> &mst_adjacency_matrix)
+void Graph<T1, T2>::FindSimpleGraphCycles(std::vector<std::string> &cycle_terminal_vertices_list)
 {
-	std::vector<std::pair<T2, std::pair<int64_t, int64_t> > > edges_list, path_edges_list;
-	std::map<int64_t, int32_t> node_uuid_index_map;
-	GenerateEdgesListAndNodeMap(edges_list, node_uuid_index_map);
-	std::sort(edges_list.begin(), edges_list.end());
+	cycle_terminal_vertices_list = {};
 
-	std::vector<std::pair<int64_t, std::vector<T2> > > intermediate_adjacency_matrix, temp_intermediate_adjacency_matrix;
-	for (const auto &elem : adjacencyMatrix_) {
-		std::vector<T2> row_edge_weights(elem.second.size(), T2(0));
-		intermediate_adjacency_matrix.push_back(std::pair<int64_t, std::vector<T2> >(elem.first.uuid_, row_edge_weights));
-	}
+	DFSEngine<T2> dfs_engine(csr_);
+	struct GraphCycleVisitor : public DFSVisitor {
+		const MappedArray<Node<T1> > &nodes_;
+		const DFSEngine<T2> &dfsEngine_;
+		std::vector<std::string> &cycle_terminal_vertices_list_;
+		std::vector<bool> parentEdgeSkippedList_;
+
+		GraphCycleVisitor(const MappedArray<Node<T1> > &nodes, const DFSEngine<T2> &dfs_engine, std::vector<std::string> &cycle_terminal_vertices_list) : nodes_(nodes), dfsEngine_(dfs_engine), cycle_terminal_vertices_list_(cycle_terminal_vertices_list), parentEdgeSkippedList_(nodes.size(), false) { }
+		void BackEdge(int32_t start_vertex, int32_t end_vertex, int64_t /*edge*/) {
+			if ((dfsEngine_.Parent(start_vertex) == end_vertex) && (!parentEdgeSkippedList_[start_vertex])) {
+				parentEdgeSkippedList_[start_vertex] = true;
+				return;
+			}
+			cycle_terminal_vertices_list_.push_back(std::to_string(nodes_[start_vertex].uuid_) + "-" + std::to_string(nodes_[end_vertex].uuid_));
+		}
+	} visitor(nodes_, dfs_engine, cycle_terminal_vertices_list);
+
+	dfs_engine.VisitAll(visitor);
+}
 
-	intermediate_adjacency_matrix[node_uuid_index_map[edges_list[0].second.first]].second[node_uuid_index_map[edges_list[0].second.second]] = edges_list[0].first;
-	intermediate_adjacency_matrix[node_uuid_index_map[edges_list[0].second.second]].second[node_uuid_index_map[edges_list[0].second.first]] = T2(-1) * edges_list[0].first;
 
-	std::set<int64_t> parsed_nodes_set;
-	parsed_nodes_set.insert(edges_list[0].second.first);
-	parsed_nodes_set.insert(edges_list[0].second.second);
+// Every back edge u-->v closes the directed cycle v --> ... --> u --> v
+template<typename T1, typename T2>
+void Graph<T1, T2>::FindDigraphCycles(std::vector<std::string> &cycle_terminal_vertices_list)
+{
+	struct DigraphCycleVisitor : public DFSVisitor {
+		std::vector<std::pair<int32_t, int32_t> > cycle_terminal_nodes_list_;
 
-	for (int32_t i = 1; (i < edges_list.size())&&(parsed_nodes_set.size() < numGraphNodes_); i++) {
-		temp_intermediate_adjacency_matrix = intermediate_adjacency_matrix;
-		temp_intermediate_adjacency_matrix[node_uuid_index_map[edges_list[i].second.first]].second[node_uuid_index_map[edges_list[i].second.second]] = edges_list[i].first;
-		temp_intermediate_adjacency_matrix[node_uuid_index_map[edges_list[i].second.second]].second[node_uuid_index_map[edges_list[i].second.first]] = T2(-1) * edges_list[i].first;
-		if (!DetectCycle(temp_intermediate_adjacency_matrix, path_edges_list)) {
-			intermediate_adjacency_matrix = temp_intermediate_adjacency_matrix;
-			if (parsed_nodes_set.count(edges_list[i].second.first) == 0)	parsed_nodes_set.insert(edges_list[i].second.first);
-			if (parsed_nodes_set.count(edges_list[i].second.second) == 0)	parsed_nodes_set.insert(edges_list[i].second.second);
+		void BackEdge(int32_t start_vertex, int32_t end_vertex, int64_t /*edge*/) {
+			cycle_terminal_nodes_list_.push_back(std::pair<int32_t, int32_t>(start_vertex, end_vertex));
 		}
-	}
+	} visitor;
 
-	// Writing the matrix for the All-To-All Shortest Path
-	std::string nodes_info_str = "\t";
-	for (const auto& elem : adjacencyMatrix_)	nodes_info_str += std::to_string(elem.first.uuid_) + "\t";
-	mst_adjacency_matrix.push_back(nodes_info_str + "\n");
+	DFSEngine<T2> dfs_engine(csr_);
+	dfs_engine.VisitAll(visitor);
 
-	for (const auto& elem : intermediate_adjacency_matrix) {
-		nodes_info_str = std::to_string(elem.first) + "\t";
-		for (const auto & elem2 : elem.second)		nodes_info_str += std::to_string(elem2) + "\t";
-		nodes_info_str += "\n";
-		mst_adjacency_matrix.push_back(nodes_info_str);
+	for (const auto& elem : visitor.cycle_terminal_nodes_list_) {
+		std::string terminal_nodes = "(" + std::to_string(nodes_[elem.first].uuid_) + "," + std::to_string(nodes_[elem.second].uuid_) + ")";
+		cycle_terminal_vertices_list.push_back(terminal_nodes);
 	}
 }
 
 
+// Every Strongly Connected Component with more than one vertex, or with a self loop, is a set of vertices that share a cycle.
+// Every such component is reported as "{uuid,uuid,...}" with its vertices in index order
 template<typename T1, typename T2>
-void Graph<T1, T2>::DijkstraMSTAlgorithm(std::vector<std::string> &mst_adjacency_matrix)
+void Graph<T1, T2>::FindDigraphCycleComponents(std::vector<std::string> &cycle_components_list)
 {
-	std::vector<std::pair<T2, std::pair<int64_t, int64_t> > > edges_list, path_edges_list; 
-	std::map<int64_t, int32_t> node_uuid_index_map;
-	GenerateEdgesListAndNodeMap(edges_list, node_uuid_index_map);
-
-	std::vector<std::pair<int64_t, std::vector<T2> > > intermediate_adjacency_matrix, temp_intermediate_adjacency_matrix;
-	for (const auto &elem : adjacencyMatrix_) {
-		std::vector<T2> row_edge_weights(elem.second.size(), T2(0));
-		intermediate_adjacency_matrix.push_back(std::pair<int64_t, std::vector<T2> >(elem.first.uuid_, row_edge_weights));
+	ComponentResult result;
+	StronglyConnectedComponents(result, 0);
+	const std::vector<int32_t> &component_list = result.components_;
+	int32_t num_components = result.numComponents_;
+
+	std::vector<int32_t> component_size_list(num_components, 0);
+	std::vector<bool> cyclic_component_list(num_components, false);
+	for (int32_t u = 0; u < numGraphNodes_; u++) {
+		if (++component_size_list[component_list[u]] > 1)		cyclic_component_list[component_list[u]] = true;
+		for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++)
+			if (csr_.Neighbor(e) == u)		cyclic_component_list[component_list[u]] = true;
 	}
 
-	intermediate_adjacency_matrix[node_uuid_index_map[edges_list[0].second.first]].second[node_uuid_index_map[edges_list[0].second.second]] = edges_list[0].first;
-	intermediate_adjacency_matrix[node_uuid_index_map[edges_list[0].second.second]].second[node_uuid_index_map[edges_list[0].second.first]] = T2(-1) * edges_list[0].first;
-
-	std::set<int64_t> parsed_nodes_set;
-	parsed_nodes_set.insert(edges_list[0].second.first);
-	parsed_nodes_set.insert(edges_list[0].second.second);
-
-	for (int32_t i = 1; (i < edges_list.size()) && (parsed_nodes_set.size() < numGraphNodes_); i++) {
-		temp_intermediate_adjacency_matrix = intermediate_adjacency_matrix;
-		temp_intermediate_adjacency_matrix[node_uuid_index_map[edges_list[i].second.first]].second[node_uuid_index_map[edges_list[i].second.second]] = edges_list[i].first;
-		temp_intermediate_adjacency_matrix[node_uuid_index_map[edges_list[i].second.second]].second[node_uuid_index_map[edges_list[i].second.first]] = T2(-1) * edges_list[i].first;
-		if (DetectCycle(temp_intermediate_adjacency_matrix, path_edges_list)) {
-			EliminateEdgeWithMaximumWeight(temp_intermediate_adjacency_matrix, path_edges_list, node_uuid_index_map);
-		}
-		intermediate_adjacency_matrix = temp_intermediate_adjacency_matrix;
-		for (const auto &elem : intermediate_adjacency_matrix)
-			for (int32_t j = 0; j < elem.second.size(); j++)
-				if (elem.second[j] > 0) {
-					if (parsed_nodes_set.count(elem.first) == 0)		
-						parsed_nodes_set.insert(elem.first);
-					if (parsed_nodes_set.count(intermediate_adjacency_matrix[j].first) == 0)		
-						parsed_nodes_set.insert(intermediate_adjacency_matrix[j].first);
-				}
+	std::vector<std::string> component_str_list(num_components);
+	std::vector<int32_t> component_order;
+	for (int32_t u = 0; u < numGraphNodes_; u++) {
+		int32_t c = component_list[u];
+		if (!cyclic_component_list[c])		continue;
+		if (component_str_list[c].empty())		component_order.push_back(c);
+		component_str_list[c] += (component_str_list[c].empty() ? "{" : ",") + std::to_string(nodes_[u].uuid_);
 	}
 
-	// Writing the matrix for the All-To-All Shortest Path
-	std::string nodes_info_str = "\t";
-	for (const auto& elem : adjacencyMatrix_)	nodes_info_str += std::to_string(elem.first.uuid_) + "\t";
-	mst_adjacency_matrix.push_back(nodes_info_str + "\n");
-
-	for (const auto& elem : intermediate_adjacency_matrix) {
-		nodes_info_str = std::to_string(elem.first) + "\t";
-		for (const auto & elem2 : elem.second)		nodes_info_str += std::to_string(elem2) + "\t";
-		nodes_info_str += "\n";
-		mst_adjacency_matrix.push_back(nodes_info_str);
-	}
+	for (const auto &elem : component_order)		cycle_components_list.push_back(component_str_list[elem] + "}");
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::GenerateEdgesListAndNodeMap(std::vector<std::pair<T2, std::pair<int64_t, int64_t> > > &edges_list, std::map<int64_t, int32_t> &node_uuid_index_map)
+void Graph<T1,T2>::TopologicalSort(std::vector<std::string> &topological_sort_vertices_list)
 {
-	int32_t index_count = 0;
-	for (const auto &elem : adjacencyMatrix_) {
-		node_uuid_index_map.insert(std::pair<int64_t, int32_t>(elem.first.uuid_, index_count));
-		++index_count;
-		for (int32_t j = 0; j < elem.second.size(); j++) 
-			if (elem.second[j] > 0)	
-				edges_list.push_back(std::pair<T2, std::pair<int64_t, int64_t> >(elem.second[j], std::pair<int64_t, int64_t>(elem.first.uuid_,adjacencyMatrix_[j].first.uuid_)));
-	}
+	CommitUpdates();
+	topological_sort_vertices_list = {};
+
+	TopologicalSortResult result;
+	TopologicalSort(result);
+	GraphPrinter<T1, T2>::WriteTopologicalOrder(*this, result, topological_sort_vertices_list);
 }
 
 
+// Kahn's algorithm, one wavefront at a time on numThreads_ threads: the vertices of the current wavefront are expanded in parallel and
+// every out-edge atomically decrements the in-degree of its end vertex; the thread that brings it to zero appends the vertex to its own
+// buffer for the next wavefront. Every vertex and edge is handled once, O(V+E), and each wavefront is sorted by vertex index so that
+// the order does not depend on the thread timing, O(V log V) over all the wavefronts. If a cycle exists, its vertices never reach
+// in-degree zero
 template<typename T1, typename T2>
-bool Graph<T1, T2>::DetectCycle(std::vector<std::pair<int64_t, std::vector<T2> > > &adjacency_matrix, std::vector<std::pair<T2, std::pair<int64_t, int64_t> > > &path_edges_list)
+void Graph<T1,T2>::TopologicalSort(TopologicalSortResult &result)
 {
-	path_edges_list = {};
+	CommitUpdates();
+	std::vector<int32_t> &topological_order = result.order_, &level_offsets = result.levelOffsets_;
+	topological_order.clear();
+	topological_order.reserve(numGraphNodes_);
+	level_offsets.assign(1, 0);
 
-	std::deque<int64_t> node_uuid_queue;
-	std::map<int64_t, int32_t> node_num_map;
-	std::map<int64_t, int32_t> node_index_map;
-	
-	for (int32_t i = 0; i < adjacency_matrix.size(); i++)	{
-		node_num_map.insert(std::pair<int64_t, int32_t>(adjacency_matrix[i].first, 0));
-		node_index_map.insert(std::pair<int64_t, int32_t>(adjacency_matrix[i].first, i));
-		node_uuid_queue.push_back(adjacency_matrix[i].first);
+	std::vector<std::atomic<int32_t> > in_degree_list(numGraphNodes_);
+	for (int32_t i = 0; i < numGraphNodes_; i++) {
+		in_degree_list[i].store(reverseCsr_.OutDegree(i), std::memory_order_relaxed);
+		if (reverseCsr_.OutDegree(i) == 0)		topological_order.push_back(i);
 	}
 
-	int32_t dfs_count = 0;
-	bool CYCLE_ABSENT_COND = true;
-	while ((!CheckNodeNumQueueIsEmpty(node_uuid_queue, node_num_map)) && (CYCLE_ABSENT_COND)) {
-		int64_t front_node_uuid = node_uuid_queue.front();
-		node_uuid_queue.pop_front();
+	ThreadPool &thread_pool = GetThreadPool();
+	std::vector<std::vector<int32_t> > local_wavefront_lists(thread_pool.NumThreads());
+	size_t level_begin = 0;
+	std::function<void(int64_t, int64_t, int32_t)> expand_wavefront = [&](int64_t begin_index, int64_t end_index, int32_t thread_id) {
+		for (int64_t i = level_begin + begin_index; i < int64_t(level_begin) + end_index; i++) {
+			int32_t u = topological_order[i];
+			for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++)
+				if (in_degree_list[csr_.Neighbor(e)].fetch_sub(1, std::memory_order_acq_rel) == 1)
+					local_wavefront_lists[thread_id].push_back(csr_.Neighbor(e));
+		}
+	};
 
-		GraphDepthCycle(adjacency_matrix, front_node_uuid, node_index_map, node_num_map, path_edges_list, dfs_count, CYCLE_ABSENT_COND);
-	}
+	while (level_begin < topological_order.size()) {
+		size_t level_end = topological_order.size();
+		level_offsets.push_back(int32_t(level_end));
 
-	return (!CYCLE_ABSENT_COND);
+		thread_pool.ParallelFor(0, level_end - level_begin, expand_wavefront, 256);
+
+		for (auto &elem : local_wavefront_lists) {
+			topological_order.insert(topological_order.end(), elem.begin(), elem.end());
+			elem.clear();
+		}
+		std::sort(topological_order.begin() + level_end, topological_order.end());
+		level_begin = level_end;
+	}
+
+	result.acyclic_ = (int32_t(topological_order.size()) == numGraphNodes_);
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::StronglyConnectedComponents(ComponentResult &result, int32_t flag)
+{
+	CommitUpdates();
+	switch (flag)
+	{
+	case 1:
+		result.numComponents_ = ForwardBackwardTrimAlgorithm(result.components_);
+		break;
+
+	case 0:
+		result.components_.assign(numGraphNodes_, -1);
+		result.numComponents_ = TarjanAlgorithm(result.components_, 0);
+		break;
+
+	default:
+		throw std::invalid_argument("ERROR: Flag " + std::to_string(flag) + " is not a Strongly Connected Components algorithm");
+	}
+}
+
+
+// Tarjan's algorithm in O(V+E) on the iterative DFSEngine. Every vertex gets a DFS index and a low link, the smallest index reachable
+// from its DFS subtree through at most one edge into a vertex still on the Tarjan stack; a vertex whose low link equals its own index
+// is the root of a component, which is popped from the stack when the vertex finishes. Vertices with component_list[v] != -1 are
+// skipped (they must form whole components already); the new components are numbered from num_components upwards in reverse
+// topological order of the condensation, i.e. a component is numbered before every component that reaches it. Returns the new count
+template<typename T1, typename T2>
+int32_t Graph<T1, T2>::TarjanAlgorithm(std::vector<int32_t> &component_list, int32_t num_components)
+{
+	DFSEngine<T2> dfs_engine(csr_);
+	for (int32_t i = 0; i < numGraphNodes_; i++)
+		if (component_list[i] != -1)		dfs_engine.Exclude(i);
+
+	struct TarjanVisitor : public DFSVisitor {
+		const DFSEngine<T2> &dfsEngine_;
+		std::vector<int32_t> &component_list_;
+		std::vector<int32_t> index_list_, low_link_list_, tarjan_stack_;
+		std::vector<bool> on_stack_list_;
+		int32_t count_, num_components_;
+
+		TarjanVisitor(const DFSEngine<T2> &dfs_engine, std::vector<int32_t> &component_list, int32_t num_components) : dfsEngine_(dfs_engine), component_list_(component_list),
+			index_list_(component_list.size(), 0), low_link_list_(component_list.size(), 0), on_stack_list_(component_list.size(), false), count_(0), num_components_(num_components) { }
+
+		void DiscoverVertex(int32_t vertex) {
+			index_list_[vertex] = low_link_list_[vertex] = count_++;
+			tarjan_stack_.push_back(vertex);
+			on_stack_list_[vertex] = true;
+		}
+		void BackEdge(int32_t start_vertex, int32_t end_vertex, int64_t /*edge*/) {
+			low_link_list_[start_vertex] = std::min(low_link_list_[start_vertex], index_list_[end_vertex]);
+		}
+		void ForwardOrCrossEdge(int32_t start_vertex, int32_t end_vertex, int64_t /*edge*/) {
+			if (on_stack_list_[end_vertex])		low_link_list_[start_vertex] = std::min(low_link_list_[start_vertex], index_list_[end_vertex]);
+		}
+		void FinishVertex(int32_t vertex) {
+			if (low_link_list_[vertex] == index_list_[vertex]) {
+				int32_t v = -1;
+				do {
+					v = tarjan_stack_.back();
+					tarjan_stack_.pop_back();
+					on_stack_list_[v] = false;
+					component_list_[v] = num_components_;
+				} while (v != vertex);
+				++num_components_;
+			}
+
+			int32_t parent = dfsEngine_.Parent(vertex);
+			if (parent != -1)		low_link_list_[parent] = std::min(low_link_list_[parent], low_link_list_[vertex]);
+		}
+	} visitor(dfs_engine, component_list, num_components);
+
+	dfs_engine.VisitAll(visitor);
+	return visitor.num_components_;
+}
+
+
+// Forward-Backward-Trim (Hong, Rodia and Olukotun) on numThreads_ threads, for large graphs where most of the vertices are either
+// trivial components or belong to one giant component:
+//   1. Trim: a vertex without in-edges or without out-edges from the remaining vertices is a component by itself. The vertices are
+//      peeled in parallel waves; removing a vertex atomically decrements the degrees of its neighbours, which may expose new ones
+//   2. Forward-Backward: the vertices both reachable from and reaching the pivot (the vertex with the largest in * out degree left)
+//      form its component; both reachability sets come from a parallel level-synchronous BFS over csr_ and reverseCsr_
+//   3. The few vertices left are handled by Tarjan, skipping everything already assigned
+// The components are numbered in increasing order of their smallest vertex
+template<typename T1, typename T2>
+int32_t Graph<T1, T2>::ForwardBackwardTrimAlgorithm(std::vector<int32_t> &component_list)
+{
+	ThreadPool &thread_pool = GetThreadPool();
+	std::vector<std::vector<int32_t> > local_trim_lists(thread_pool.NumThreads());
+
+	// label_list[v] = Representative vertex of the component of v, -1 if not assigned yet
+	std::vector<std::atomic<int32_t> > label_list(numGraphNodes_), in_degree_list(numGraphNodes_), out_degree_list(numGraphNodes_);
+	std::vector<int32_t> trim_frontier;
+	for (int32_t u = 0; u < numGraphNodes_; u++) {
+		int32_t in_degree = 0, out_degree = 0;
+		for (int64_t e = reverseCsr_.EdgeBegin(u); e < reverseCsr_.EdgeEnd(u); e++)		in_degree += (reverseCsr_.Neighbor(e) != u);
+		for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++)		out_degree += (csr_.Neighbor(e) != u);
+
+		in_degree_list[u].store(in_degree, std::memory_order_relaxed);
+		out_degree_list[u].store(out_degree, std::memory_order_relaxed);
+		label_list[u].store(((in_degree == 0) || (out_degree == 0)) ? u : -1, std::memory_order_relaxed);
+		if ((in_degree == 0) || (out_degree == 0))		trim_frontier.push_back(u);
+	}
+
+	auto trim_vertex = [&](int32_t v, std::atomic<int32_t> &degree, int32_t thread_id) {
+		int32_t unassigned_label = -1;
+		if ((degree.fetch_sub(1, std::memory_order_acq_rel) == 1) && (label_list[v].compare_exchange_strong(unassigned_label, v, std::memory_order_acq_rel)))
+			local_trim_lists[thread_id].push_back(v);
+	};
+	std::function<void(int64_t, int64_t, int32_t)> trim_wave = [&](int64_t begin_index, int64_t end_index, int32_t thread_id) {
+		for (int64_t i = begin_index; i < end_index; i++) {
+			int32_t u = trim_frontier[i];
+			for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++)
+				if (csr_.Neighbor(e) != u)		trim_vertex(csr_.Neighbor(e), in_degree_list[csr_.Neighbor(e)], thread_id);
+			for (int64_t e = reverseCsr_.EdgeBegin(u); e < reverseCsr_.EdgeEnd(u); e++)
+				if (reverseCsr_.Neighbor(e) != u)		trim_vertex(reverseCsr_.Neighbor(e), out_degree_list[reverseCsr_.Neighbor(e)], thread_id);
+		}
+	};
+
+	while (!trim_frontier.empty()) {
+		thread_pool.ParallelFor(0, trim_frontier.size(), trim_wave, 256);
+
+		trim_frontier.clear();
+		for (auto &elem : local_trim_lists) {
+			trim_frontier.insert(trim_frontier.end(), elem.begin(), elem.end());
+			elem.clear();
+		}
+	}
+
+	int32_t pivot_vertex = -1;
+	int64_t pivot_degree = -1;
+	for (int32_t u = 0; u < numGraphNodes_; u++) {
+		if (label_list[u].load(std::memory_order_relaxed) != -1)		continue;
+		int64_t degree = int64_t(in_degree_list[u].load(std::memory_order_relaxed)) * out_degree_list[u].load(std::memory_order_relaxed);
+		if (degree > pivot_degree) {
+			pivot_vertex = u;
+			pivot_degree = degree;
+		}
+	}
+
+	if (pivot_vertex != -1) {
+		std::vector<std::atomic<uint64_t> > forward_bitmap((numGraphNodes_ + 63) / 64), backward_bitmap((numGraphNodes_ + 63) / 64);
+		ParallelReach(csr_, pivot_vertex, label_list, forward_bitmap, thread_pool);
+		ParallelReach(reverseCsr_, pivot_vertex, label_list, backward_bitmap, thread_pool);
+
+		thread_pool.ParallelFor(0, numGraphNodes_, [&](int64_t begin_index, int64_t end_index, int32_t /*thread_id*/) {
+			for (int32_t u = int32_t(begin_index); u < int32_t(end_index); u++)
+				if ((forward_bitmap[u >> 6].load(std::memory_order_relaxed) & backward_bitmap[u >> 6].load(std::memory_order_relaxed)) >> (u & 63) & 1)
+					label_list[u].store(pivot_vertex, std::memory_order_relaxed);
+		}, 4096);
+	}
+
+	component_list.resize(numGraphNodes_);
+	for (int32_t u = 0; u < numGraphNodes_; u++)		component_list[u] = label_list[u].load(std::memory_order_relaxed);
+
+	// The Tarjan components are numbered from numGraphNodes_ so they never collide with the representative vertices
+	TarjanAlgorithm(component_list, numGraphNodes_);
+
+	std::vector<int32_t> component_id_list(2 * numGraphNodes_, -1);
+	int32_t num_components = 0;
+	for (int32_t u = 0; u < numGraphNodes_; u++) {
+		int32_t &component_id = component_id_list[component_list[u]];
+		if (component_id == -1)		component_id = num_components++;
+		component_list[u] = component_id;
+	}
+
+	return num_components;
+}
+
+
+// Marks in reached_bitmap every vertex with label -1 that is reachable from source_vertex over the edges of csr, level by level
+// in parallel; a vertex is claimed by the thread whose fetch_or sets its bit first
+template<typename T1, typename T2>
+void Graph<T1, T2>::ParallelReach(const CSRGraph<T2> &csr, int32_t source_vertex, const std::vector<std::atomic<int32_t> > &label_list, std::vector<std::atomic<uint64_t> > &reached_bitmap, ThreadPool &thread_pool)
+{
+	for (auto &elem : reached_bitmap)		elem.store(0, std::memory_order_relaxed);
+	reached_bitmap[source_vertex >> 6].store(uint64_t(1) << (source_vertex & 63), std::memory_order_relaxed);
+
+	std::vector<std::vector<int32_t> > local_frontier_lists(thread_pool.NumThreads());
+	std::vector<int32_t> frontier(1, source_vertex);
+	std::function<void(int64_t, int64_t, int32_t)> expand_frontier = [&](int64_t begin_index, int64_t end_index, int32_t thread_id) {
+		for (int64_t i = begin_index; i < end_index; i++) {
+			int32_t u = frontier[i];
+			for (int64_t e = csr.EdgeBegin(u); e < csr.EdgeEnd(u); e++) {
+				int32_t v = csr.Neighbor(e);
+				if (label_list[v].load(std::memory_order_relaxed) != -1)		continue;
+
+				uint64_t bit = uint64_t(1) << (v & 63);
+				if ((reached_bitmap[v >> 6].load(std::memory_order_relaxed) & bit) == 0)
+					if ((reached_bitmap[v >> 6].fetch_or(bit, std::memory_order_relaxed) & bit) == 0)
+						local_frontier_lists[thread_id].push_back(v);
+			}
+		}
+	};
+
+	while (!frontier.empty()) {
+		thread_pool.ParallelFor(0, frontier.size(), expand_frontier, 64);
+
+		frontier.clear();
+		for (auto &elem : local_frontier_lists) {
+			frontier.insert(frontier.end(), elem.begin(), elem.end());
+			elem.clear();
+		}
+	}
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::ShortestPathAlgorithm(std::vector<std::string> &shortest_path, int32_t flag, int32_t start_vertex_index)
+{
+	NullPathTracer<T2> tracer;
+	ShortestPathAlgorithm(shortest_path, flag, start_vertex_index, tracer);
+}
+
+
+template<typename T1, typename T2>
+template<typename Tracer>
+void Graph<T1, T2>::ShortestPathAlgorithm(std::vector<std::string> &shortest_path, int32_t flag, int32_t start_vertex_index, Tracer &tracer)
+{
+	CommitUpdates();
+	shortest_path = {};
+
+	switch (flag)
+	{
+	case 0:
+	case 1:
+	case 2:
+	case 4:
+	case 5:
+	{
+		ShortestPathResult<T2> result;
+		ShortestPathAlgorithm(result, flag, start_vertex_index, tracer);
+		GraphPrinter<T1, T2>::WriteShortestPath(*this, result, shortest_path);
+		break;
+	}
+
+	case 3:
+	case 6:
+	{
+		// All to All Shortest Path Algorithm
+		AllPairsShortestPathResult<T2> result;
+		AllPairsShortestPath(result, (flag == 6) ? 1 : 0);
+		GraphPrinter<T1, T2>::WriteAllPairsShortestPath(*this, result, shortest_path);
+		break;
+	}
+
+	default:
+		throw std::invalid_argument("ERROR: Flag " + std::to_string(flag) + " is not a Shortest Path algorithm");
+	}
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::ShortestPathAlgorithm(ShortestPathResult<T2> &result, int32_t flag, int32_t start_vertex_index)
+{
+	NullPathTracer<T2> tracer;
+	ShortestPathAlgorithm(result, flag, start_vertex_index, tracer);
+}
+
+
+template<typename T1, typename T2>
+template<typename Tracer>
+void Graph<T1, T2>::ShortestPathAlgorithm(ShortestPathResult<T2> &result, int32_t flag, int32_t start_vertex_index, Tracer &tracer)
+{
+	CommitUpdates();
+	switch (flag)
+	{
+	case 0:
+		DijkstraShortestPathAlgorithm(result, start_vertex_index, tracer);
+		break;
+
+	case 1:
+		FordAlgorithm(result, start_vertex_index, tracer);
+		break;
+
+	case 2:
+		GenericLabelCorrectingAlgorithm(result, start_vertex_index, tracer);
+		break;
+
+	case 4:
+		DeltaSteppingAlgorithm(result, start_vertex_index, tracer);
+		break;
+
+	case 5:
+		ParallelBellmanFordAlgorithm(result, start_vertex_index, tracer);
+		break;
+
+	default:
+		throw std::invalid_argument("ERROR: Flag " + std::to_string(flag) + " is not a Single Source Shortest Path algorithm");
+	}
 }
 
 
 template<typename T1, typename T2>
-void Graph<T1, T2>::GraphDepthCycle(std::vector<std::pair<int64_t, std::vector<T2> > > &adjacency_matrix, int64_t front_node_uuid, std::map<int64_t, int32_t> &node_index_map, std::map<int64_t, int32_t> &node_num_map, std::vector<std::pair<T2, std::pair<int64_t, int64_t> > > &path_edges_list, int32_t &dfs_count, bool &CYCLE_ABSENT_COND)
+void Graph<T1, T2>::InitShortestPathResult(ShortestPathResult<T2> &result, int32_t start_vertex_index)
 {
-	node_num_map[front_node_uuid] = ++dfs_count;
-	for (int32_t j = 0; (j < adjacency_matrix.size()) && (CYCLE_ABSENT_COND); j++)
-		if (adjacency_matrix[node_index_map[front_node_uuid]].second[j] > 0 /* !=0 && !-ve*/) {
-			if (node_num_map[adjacency_matrix[j].first] == 0) {
-				GraphDepthCycle(adjacency_matrix, adjacency_matrix[j].first, node_index_map, node_num_map, path_edges_list, dfs_count, CYCLE_ABSENT_COND);
-				if (!CYCLE_ABSENT_COND)		
-					path_edges_list.insert(path_edges_list.begin(), std::pair<T2, std::pair<int64_t, int64_t> >(adjacency_matrix[node_index_map[front_node_uuid]].second[j], std::pair<int64_t, int64_t>(front_node_uuid, adjacency_matrix[j].first)));
-			} else if (path_edges_list.empty()) {
-				// Cycle detected in the Graph: MST not possible with this cycle
-				CYCLE_ABSENT_COND = false;
-				path_edges_list.insert(path_edges_list.begin(), std::pair<T2, std::pair<int64_t, int64_t> >(adjacency_matrix[node_index_map[front_node_uuid]].second[j], std::pair<int64_t, int64_t>(front_node_uuid, adjacency_matrix[j].first)));
+	if ((start_vertex_index < 0) || (start_vertex_index >= numGraphNodes_))
+		throw std::out_of_range("ERROR: Start vertex index " + std::to_string(start_vertex_index) + " is out of range");
+
+	result.sourceVertex_ = start_vertex_index;
+	result.distances_.assign(numGraphNodes_, T2(INFINITE_WEIGHT));
+	result.predecessors_.assign(numGraphNodes_, -1);
+	result.distances_[start_vertex_index] = T2(0);
+	result.negativeCycle_.clear();
+	result.numIterations_ = 0;
+}
+
+
+template<typename T1, typename T2>
+ThreadPool& Graph<T1, T2>::GetThreadPool()
+{
+	int32_t num_threads = (numThreads_ > 0) ? numThreads_ : ThreadPool::HardwareThreads();
+	if ((!threadPool_) || (threadPool_->NumThreads() != num_threads))
+		threadPool_ = std::make_shared<ThreadPool>(num_threads);
+
+	return *threadPool_;
+}
+
+
+template<typename T1, typename T2>
+bool Graph<T1, T2>::HasNegativeWeights()
+{
+	if (negativeWeightState_ < 0) {
+		negativeWeightState_ = 0;
+		for (int64_t e = 0; (e < csr_.NumEdges()) && (negativeWeightState_ == 0); e++)
+			if (csr_.Weight(e) < T2(0))		negativeWeightState_ = 1;
+	}
+	return negativeWeightState_ == 1;
+}
+
+
+// Follows the predecessors of vertex numGraphNodes_ times: if the chain does not end at -1 it repeats a vertex, and the
+// cycle through that vertex is returned in edge order, starting at its lowest index
+template<typename T1, typename T2>
+bool Graph<T1, T2>::FindPredecessorCycle(const std::vector<int32_t> &predecessor_list, int32_t vertex, std::vector<int32_t> &cycle_node_list)
+{
+	for (int32_t i = 0; i < numGraphNodes_; i++) {
+		vertex = predecessor_list[vertex];
+		if (vertex == -1)		return false;
+	}
+
+	cycle_node_list.clear();
+	int32_t cycle_node = vertex;
+	do {
+		cycle_node_list.push_back(cycle_node);
+		cycle_node = predecessor_list[cycle_node];
+	} while (cycle_node != vertex);
+
+	std::reverse(cycle_node_list.begin(), cycle_node_list.end());
+	std::rotate(cycle_node_list.begin(), std::min_element(cycle_node_list.begin(), cycle_node_list.end()), cycle_node_list.end());
+	return true;
+}
+
+
+// Sets the predecessors from the final distances with a BFS over the tight edges (d(u) + w = d(v)) from the source. Unlike
+// taking any tight edge, the BFS cannot close a cycle of zero weight edges
+template<typename T1, typename T2>
+void Graph<T1, T2>::BuildShortestPathTree(ShortestPathResult<T2> &result)
+{
+	result.predecessors_.assign(numGraphNodes_, -1);
+	std::vector<bool> visited_list(numGraphNodes_, false);
+	std::vector<int32_t> frontier(1, result.sourceVertex_);
+	visited_list[result.sourceVertex_] = true;
+
+	for (size_t i = 0; i < frontier.size(); i++) {
+		int32_t u = frontier[i];
+		for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++) {
+			int32_t v = csr_.Neighbor(e);
+			if ((!visited_list[v]) && (result.distances_[u] + csr_.Weight(e) == result.distances_[v])) {
+				visited_list[v] = true;
+				result.predecessors_[v] = u;
+				frontier.push_back(v);
 			}
 		}
+	}
 }
 
 
+// Dijkstra's algorithm with an addressable 4-ary heap keyed on the dense node indices: every vertex is settled once
+// and every edge relaxed once, each heap operation costing O(log V), i.e. O((V+E) log V) overall
 template<typename T1, typename T2>
-void Graph<T1, T2>::EliminateEdgeWithMaximumWeight(std::vector<std::pair<int64_t, std::vector<T2> > > &adjacency_matrix, std::vector<std::pair<T2, std::pair<int64_t, int64_t> > > &path_edges_list, std::map<int64_t, int32_t> &node_uuid_index_map)
+template<typename Tracer>
+void Graph<T1, T2>::DijkstraShortestPathAlgorithm(ShortestPathResult<T2> &result, int32_t start_vertex_index, Tracer &tracer)
 {
-	std::sort(path_edges_list.begin(), path_edges_list.end());
+	if (HasNegativeWeights())
+		throw std::invalid_argument("ERROR: Dijkstra requires non-negative edge weights, use Ford or Generic Label Correcting");
+
+	InitShortestPathResult(result, start_vertex_index);
+	std::vector<T2> &distance_list = result.distances_;
+	std::vector<int32_t> &predecessor_list = result.predecessors_;
+
+	IndexedHeap<T2> node_index_heap(numGraphNodes_);
+	node_index_heap.Push(start_vertex_index, distance_list[start_vertex_index]);
+	tracer.QueuePush(start_vertex_index);
+
+	int32_t count = 0;
+	while (!node_index_heap.Empty())
+	{
+		int32_t minimal_curr_dist_node_index = node_index_heap.Pop();
+		tracer.QueuePop(minimal_curr_dist_node_index);
+
+		for (int64_t e = csr_.EdgeBegin(minimal_curr_dist_node_index); e < csr_.EdgeEnd(minimal_curr_dist_node_index); e++) {
+			int32_t j = csr_.Neighbor(e);
+			if (distance_list[j] > distance_list[minimal_curr_dist_node_index] + csr_.Weight(e)) {
+				distance_list[j] = distance_list[minimal_curr_dist_node_index] + csr_.Weight(e);
+				predecessor_list[j] = minimal_curr_dist_node_index;
+				tracer.Relaxation(minimal_curr_dist_node_index, j, distance_list[j]);
+				if (!node_index_heap.Contains(j))		tracer.QueuePush(j);
+				node_index_heap.PushOrDecreaseKey(j, distance_list[j]);
+			}
+		}
+
+		++count;
+		if (Tracer::LABEL_SNAPSHOTS)		tracer.Iteration(count, result);
+	}
+
+	result.numIterations_ = count;
+}
+
+
+// Bellman-Ford on a FIFO of the vertices whose distance changed (SPFA). The in-queue bitset keeps every vertex at most once in
+// the queue, and the algorithm stops as soon as the queue runs empty instead of sweeping all the edges V-1 times. An iteration is
+// the scan of the vertices queued during the previous one, so after k iterations all the shortest paths of at most k edges are known.
+// path_length_list counts the edges of the path behind every label: a path of V edges repeats a vertex, which means a negative
+// cycle once the predecessors close it. The cycle is returned in result.negativeCycle_ and the distances are then meaningless
+template<typename T1, typename T2>
+template<typename Tracer>
+void Graph<T1, T2>::FordAlgorithm(ShortestPathResult<T2> &result, int32_t start_vertex_index, Tracer &tracer)
+{
+	InitShortestPathResult(result, start_vertex_index);
+	std::vector<T2> &distance_list = result.distances_;
+	std::vector<int32_t> &predecessor_list = result.predecessors_;
+
+	std::vector<bool> in_queue_bitset(numGraphNodes_, false);
+	std::vector<int32_t> path_length_list(numGraphNodes_, 0);
+	std::deque<int32_t> node_index_queue(1, start_vertex_index);
+	in_queue_bitset[start_vertex_index] = true;
+	tracer.QueuePush(start_vertex_index);
+
+	int64_t iteration_count = 0;
+	size_t iteration_node_count = 1;		// Vertices of the current iteration still in the queue
+	while (!node_index_queue.empty()) {
+		int32_t u = node_index_queue.front();
+		node_index_queue.pop_front();
+		in_queue_bitset[u] = false;
+		tracer.QueuePop(u);
+
+		for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++) {
+			int32_t v = csr_.Neighbor(e);
+			if (distance_list[v] > distance_list[u] + csr_.Weight(e)) {
+				distance_list[v] = distance_list[u] + csr_.Weight(e);
+				predecessor_list[v] = u;
+				path_length_list[v] = path_length_list[u] + 1;
+				tracer.Relaxation(u, v, distance_list[v]);
+
+				if ((path_length_list[v] >= numGraphNodes_) && (FindPredecessorCycle(predecessor_list, v, result.negativeCycle_))) {
+					result.numIterations_ = iteration_count + 1;
+					return;
+				}
+
+				if (!in_queue_bitset[v]) {
+					in_queue_bitset[v] = true;
+					node_index_queue.push_back(v);
+					tracer.QueuePush(v);
+				}
+			}
+		}
+
+		if (--iteration_node_count == 0) {
+			++iteration_count;
+			if (Tracer::LABEL_SNAPSHOTS)		tracer.Iteration(iteration_count, result);
+			iteration_node_count = node_index_queue.size();
+		}
+	}
+
+	result.numIterations_ = iteration_count;
+}
+
+
+// Frontier based Bellman-Ford: every iteration relaxes the out edges of the vertices whose distance changed in the previous one
+// in parallel, lowering the distances with an atomic compare-and-swap and collecting the changed vertices in thread local lists.
+// Without a negative cycle the frontier runs empty within V iterations; if it does not, the serial Ford algorithm is rerun to
+// extract the cycle. The predecessors are rebuilt from the final distances
+template<typename T1, typename T2>
+template<typename Tracer>
+void Graph<T1, T2>::ParallelBellmanFordAlgorithm(ShortestPathResult<T2> &result, int32_t start_vertex_index, Tracer &tracer)
+{
+	InitShortestPathResult(result, start_vertex_index);
+	std::vector<T2> &result_distance_list = result.distances_;
+	std::vector<int32_t> &predecessor_list = result.predecessors_;
+
+	std::vector<std::atomic<T2> > distance_list(numGraphNodes_);
+	for (int32_t i = 0; i < numGraphNodes_; i++)		distance_list[i].store(result_distance_list[i], std::memory_order_relaxed);
+
+	ThreadPool &thread_pool = GetThreadPool();
+	std::vector<std::vector<int32_t> > local_changed_lists(thread_pool.NumThreads());
+	// (v, u, d): the relaxation of u-->v lowered the distance of v to d, kept for the predecessors of the label snapshots only
+	std::vector<std::vector<std::tuple<int32_t, int32_t, T2> > > local_label_lists(thread_pool.NumThreads());
+	std::vector<int64_t> frontier_stamp_list(numGraphNodes_, -1);
+	std::vector<int32_t> frontier(1, start_vertex_index);
+
+	std::function<void(int64_t, int64_t, int32_t)> relax_edges = [&](int64_t begin_index, int64_t end_index, int32_t thread_id) {
+		for (int64_t i = begin_index; i < end_index; i++) {
+			int32_t u = frontier[i];
+			T2 u_distance = distance_list[u].load(std::memory_order_relaxed);
+			for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++) {
+				int32_t v = csr_.Neighbor(e);
+				T2 new_distance = u_distance + csr_.Weight(e);
+				T2 v_distance = distance_list[v].load(std::memory_order_relaxed);
+				while (new_distance < v_distance)
+					if (distance_list[v].compare_exchange_weak(v_distance, new_distance, std::memory_order_relaxed)) {
+						local_changed_lists[thread_id].push_back(v);
+						if (Tracer::LABEL_SNAPSHOTS)		local_label_lists[thread_id].push_back(std::make_tuple(v, u, new_distance));
+						break;
+					}
+			}
+		}
+	};
+
+	int64_t iteration_count = 0;
+	while (!frontier.empty()) {
+		if (iteration_count == numGraphNodes_) {
+			NullPathTracer<T2> null_tracer;
+			FordAlgorithm(result, start_vertex_index, null_tracer);
+			result.numIterations_ = iteration_count;
+			return;
+		}
+
+		thread_pool.ParallelFor(0, frontier.size(), relax_edges, 256);
+
+		frontier.clear();
+		for (auto &elem : local_changed_lists) {
+			for (const auto &v : elem)
+				if (frontier_stamp_list[v] != iteration_count) {
+					frontier_stamp_list[v] = iteration_count;
+					frontier.push_back(v);
+				}
+			elem.clear();
+		}
+
+		++iteration_count;
+		if (Tracer::LABEL_SNAPSHOTS) {
+			for (int32_t i = 0; i < numGraphNodes_; i++)		result_distance_list[i] = distance_list[i].load(std::memory_order_relaxed);
+			for (auto &elem : local_label_lists) {
+				for (const auto &label : elem)
+					if (std::get<2>(label) == result_distance_list[std::get<0>(label)])		predecessor_list[std::get<0>(label)] = std::get<1>(label);
+				elem.clear();
+			}
+			tracer.Iteration(iteration_count, result);
+		}
+	}
+
+	for (int32_t i = 0; i < numGraphNodes_; i++)		result_distance_list[i] = distance_list[i].load(std::memory_order_relaxed);
+	BuildShortestPathTree(result);
+	result.numIterations_ = iteration_count;
+}
+
+
+// Label correcting on a deque of the vertices whose distance changed, with an in-queue bitset so that membership is O(1) and a
+// vertex is never queued twice. The queue discipline is set by labelCorrectingQueuePolicy_:
+//   SLF (Small Label First): a vertex whose distance is below the one at the front is pushed at the front instead of the back
+//   LLL (Large Label Last):  a front vertex whose distance is above the average distance in the queue is moved to the back
+// Both are O(1) per queue operation. Negative cycles are detected by path length as in FordAlgorithm
+template<typename T1, typename T2>
+template<typename Tracer>
+void Graph<T1, T2>::GenericLabelCorrectingAlgorithm(ShortestPathResult<T2> &result, int32_t start_vertex_index, Tracer &tracer)
+{
+	InitShortestPathResult(result, start_vertex_index);
+	std::vector<T2> &distance_list = result.distances_;
+	std::vector<int32_t> &predecessor_list = result.predecessors_;
+
+	bool SMALL_LABEL_FIRST_COND = (labelCorrectingQueuePolicy_ & 1) != 0;
+	bool LARGE_LABEL_LAST_COND = (labelCorrectingQueuePolicy_ & 2) != 0;
+
+	std::vector<bool> in_queue_bitset(numGraphNodes_, false);
+	std::vector<int32_t> path_length_list(numGraphNodes_, 0);
+	std::deque<int32_t> node_index_queue(1, start_vertex_index);
+	in_queue_bitset[start_vertex_index] = true;
+	double queue_distance_sum = double(distance_list[start_vertex_index]);		// Sum of the distances of the queued vertices, for LLL
+	tracer.QueuePush(start_vertex_index);
+
+	int32_t count = 0;
+	while (!node_index_queue.empty())
+	{
+		if (LARGE_LABEL_LAST_COND)
+			for (size_t i = 1; (i < node_index_queue.size()) && (double(distance_list[node_index_queue.front()]) * node_index_queue.size() > queue_distance_sum); i++) {
+				node_index_queue.push_back(node_index_queue.front());
+				node_index_queue.pop_front();
+			}
+
+		int32_t minimal_curr_dist_node_index = node_index_queue.front();
+		node_index_queue.pop_front();
+		in_queue_bitset[minimal_curr_dist_node_index] = false;
+		queue_distance_sum -= double(distance_list[minimal_curr_dist_node_index]);
+		tracer.QueuePop(minimal_curr_dist_node_index);
+
+		for (int64_t e = csr_.EdgeBegin(minimal_curr_dist_node_index); e < csr_.EdgeEnd(minimal_curr_dist_node_index); e++) {
+			int32_t j = csr_.Neighbor(e);
+			if (distance_list[j] > distance_list[minimal_curr_dist_node_index] + csr_.Weight(e)) {
+				if (in_queue_bitset[j])		queue_distance_sum -= double(distance_list[j]);
+				distance_list[j] = distance_list[minimal_curr_dist_node_index] + csr_.Weight(e);
+				predecessor_list[j] = minimal_curr_dist_node_index;
+				path_length_list[j] = path_length_list[minimal_curr_dist_node_index] + 1;
+				tracer.Relaxation(minimal_curr_dist_node_index, j, distance_list[j]);
+
+				if ((path_length_list[j] >= numGraphNodes_) && (FindPredecessorCycle(predecessor_list, j, result.negativeCycle_))) {
+					result.numIterations_ = count + 1;
+					return;
+				}
+
+				if (in_queue_bitset[j]) {
+					queue_distance_sum += double(distance_list[j]);
+					continue;
+				}
+
+				in_queue_bitset[j] = true;
+				queue_distance_sum += double(distance_list[j]);
+				if ((SMALL_LABEL_FIRST_COND) && (!node_index_queue.empty()) && (distance_list[j] < distance_list[node_index_queue.front()]))
+					node_index_queue.push_front(j);
+				else node_index_queue.push_back(j);
+				tracer.QueuePush(j);
+			}
+		}
+
+		++count;
+		if (Tracer::LABEL_SNAPSHOTS)		tracer.Iteration(count, result);
+	}
+
+	result.numIterations_ = count;
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::PointToPointShortestPath(PointToPointResult<T2> &result, int32_t start_vertex_index, int32_t target_vertex_index, int32_t flag)
+{
+	CommitUpdates();
+	if ((start_vertex_index < 0) || (start_vertex_index >= numGraphNodes_) || (target_vertex_index < 0) || (target_vertex_index >= numGraphNodes_))
+		throw std::out_of_range("ERROR: Vertex index " + std::to_string(start_vertex_index) + " or " + std::to_string(target_vertex_index) + " is out of range");
+	if (HasNegativeWeights())
+		throw std::invalid_argument("ERROR: Point-to-point queries require non-negative edge weights");
+
+	if (forwardSearch_.NumVertices() != numGraphNodes_) {
+		forwardSearch_.Resize(numGraphNodes_, T2(INFINITE_WEIGHT));
+		backwardSearch_.Resize(numGraphNodes_, T2(INFINITE_WEIGHT));
+	}
+	forwardSearch_.Reset();
+	backwardSearch_.Reset();
+
+	result.sourceVertex_ = start_vertex_index;
+	result.targetVertex_ = target_vertex_index;
+	result.distance_ = T2(INFINITE_WEIGHT);
+	result.path_.clear();
+	result.numSettledVertices_ = 0;
+
+	switch (flag)
+	{
+	case 0:
+		BidirectionalDijkstraAlgorithm(result);
+		break;
+
+	case 1:
+		LandmarkAStarAlgorithm(result);
+		break;
+
+	case 2:
+		ContractionHierarchyAlgorithm(result);
+		break;
+
+	default:
+		throw std::invalid_argument("ERROR: Flag " + std::to_string(flag) + " is not a Point-To-Point Shortest Path algorithm");
+	}
+}
 
-	adjacency_matrix[node_uuid_index_map[path_edges_list[path_edges_list.size() - 1].second.first]].second[node_uuid_index_map[path_edges_list[path_edges_list.size() - 1].second.second]] = 0;
-	adjacency_matrix[node_uuid_index_map[path_edges_list[path_edges_list.size() - 1].second.second]].second[node_uuid_index_map[path_edges_list[path_edges_list.size() - 1].second.first]] = 0;
+
+// Dijkstra from the source on csr_ and from the target on reverseCsr_, always advancing the search with the smaller heap top.
+// mu is the shortest source-->target distance seen so far through an edge between the two search spaces; once the sum of
+// both heap tops reaches mu no unsettled vertex can lie on a shorter path, so the query stops. Requires non-negative weights
+template<typename T1, typename T2>
+void Graph<T1, T2>::BidirectionalDijkstraAlgorithm(PointToPointResult<T2> &result)
+{
+	int32_t start_vertex_index = result.sourceVertex_, target_vertex_index = result.targetVertex_;
+	forwardSearch_.Label(start_vertex_index, T2(0), -1);
+	forwardSearch_.heap_.Push(start_vertex_index, T2(0));
+	backwardSearch_.Label(target_vertex_index, T2(0), -1);
+	backwardSearch_.heap_.Push(target_vertex_index, T2(0));
+
+	T2 mu = T2(INFINITE_WEIGHT);
+	int32_t meeting_vertex = (start_vertex_index == target_vertex_index) ? start_vertex_index : -1;
+	if (meeting_vertex != -1)		mu = T2(0);
+
+	while ((!forwardSearch_.heap_.Empty()) && (!backwardSearch_.heap_.Empty())) {
+		if (!(forwardSearch_.heap_.TopKey() + backwardSearch_.heap_.TopKey() < mu))		break;
+
+		bool FORWARD_SEARCH_COND = !(backwardSearch_.heap_.TopKey() < forwardSearch_.heap_.TopKey());
+		SearchSpace<T2> &search = FORWARD_SEARCH_COND ? forwardSearch_ : backwardSearch_;
+		SearchSpace<T2> &opposite_search = FORWARD_SEARCH_COND ? backwardSearch_ : forwardSearch_;
+		const CSRGraph<T2> &csr = FORWARD_SEARCH_COND ? csr_ : reverseCsr_;
+
+		int32_t u = search.heap_.Pop();
+		++result.numSettledVertices_;
+		for (int64_t e = csr.EdgeBegin(u); e < csr.EdgeEnd(u); e++) {
+			int32_t v = csr.Neighbor(e);
+			T2 new_distance = search.Distance(u) + csr.Weight(e);
+			if (new_distance < search.Distance(v)) {
+				search.Label(v, new_distance, u);
+				search.heap_.PushOrDecreaseKey(v, new_distance);
+			}
+			if ((opposite_search.Reached(v)) && (new_distance + opposite_search.Distance(v) < mu)) {
+				mu = new_distance + opposite_search.Distance(v);
+				meeting_vertex = v;
+			}
+		}
+	}
+
+	if (meeting_vertex == -1)		return;
+	result.distance_ = mu;
+	BuildPointToPointPath(result, meeting_vertex);
+}
+
+
+// Joins the forward parents from the meeting vertex back to the source with the backward parents on to the target.
+// A parent u of v in the forward search means the edge u-->v, in the backward search the edge v-->u
+template<typename T1, typename T2>
+void Graph<T1, T2>::BuildPointToPointPath(PointToPointResult<T2> &result, int32_t meeting_vertex)
+{
+	for (int32_t v = meeting_vertex; v != -1; v = forwardSearch_.Parent(v))
+		result.path_.push_back(v);
+	std::reverse(result.path_.begin(), result.path_.end());
+	for (int32_t v = backwardSearch_.Parent(meeting_vertex); v != -1; v = backwardSearch_.Parent(v))
+		result.path_.push_back(v);
+}
+
+
+// Plain Dijkstra from source_vertex on csr that only uses its arguments, so the preprocessing threads can run it concurrently.
+// settled_order_list receives the reached vertices in the order they are settled, i.e. every vertex after its parent
+template<typename T1, typename T2>
+void Graph<T1, T2>::SingleSourceDistances(const CSRGraph<T2> &csr, int32_t source_vertex, std::vector<T2> &distance_list, std::vector<int32_t> &parent_list, std::vector<int32_t> &settled_order_list, IndexedHeap<T2> &heap)
+{
+	distance_list.assign(numGraphNodes_, T2(INFINITE_WEIGHT));
+	parent_list.assign(numGraphNodes_, -1);
+	settled_order_list.clear();
+	heap.Clear();
+
+	distance_list[source_vertex] = T2(0);
+	heap.Push(source_vertex, T2(0));
+	while (!heap.Empty()) {
+		int32_t u = heap.Pop();
+		settled_order_list.push_back(u);
+		for (int64_t e = csr.EdgeBegin(u); e < csr.EdgeEnd(u); e++) {
+			int32_t v = csr.Neighbor(e);
+			if (distance_list[u] + csr.Weight(e) < distance_list[v]) {
+				distance_list[v] = distance_list[u] + csr.Weight(e);
+				parent_list[v] = u;
+				heap.PushOrDecreaseKey(v, distance_list[v]);
+			}
+		}
+	}
+}
+
+
+// Selects the landmarks one at a time, each needing the distances from the landmarks already chosen:
+//   Farthest: the vertex whose nearest landmark is the farthest away (vertices no landmark reaches come first)
+//   Avoid (Goldberg and Werneck): grow a shortest path tree from a random root, weigh every vertex by how far the current
+//             landmark bound d(L,v) - d(L,root) falls short of d(root,v), and walk down from the root into the heaviest
+//             subtree that holds no landmark; the leaf reached is the new landmark, far from the landmarks that cover the root well
+// The distances to the landmarks are then computed on reverseCsr_ in parallel, one landmark per task, and both tables are
+// transposed to vertex-major order so that a query reads the K bounds of a vertex from one cache line
+template<typename T1, typename T2>
+void Graph<T1, T2>::PreprocessLandmarks(int32_t num_landmarks, int32_t flag)
+{
+	CommitUpdates();
+	if (HasNegativeWeights())
+		throw std::invalid_argument("ERROR: Landmark distances require non-negative edge weights");
+
+	num_landmarks = std::max(0, std::min(num_landmarks, numGraphNodes_));
+	landmarkList_.clear();
+	std::vector<std::vector<T2> > from_distance_rows(num_landmarks), to_distance_rows(num_landmarks);
+
+	IndexedHeap<T2> heap(numGraphNodes_);
+	std::vector<T2> root_distance_list, weight_list;
+	std::vector<int32_t> parent_list, settled_order_list, heaviest_child_list;
+	std::vector<bool> is_landmark_list(numGraphNodes_, false), landmark_subtree_list;
+	std::mt19937 random_generator(static_cast<uint32_t>(numGraphNodes_));
+
+	while (int32_t(landmarkList_.size()) < num_landmarks) {
+		int32_t k = int32_t(landmarkList_.size()), landmark = -1;
+
+		if (flag == 1) {
+			int32_t root = int32_t(random_generator() % uint32_t(numGraphNodes_));
+			SingleSourceDistances(csr_, root, root_distance_list, parent_list, settled_order_list, heap);
+
+			// weight_list holds the subtree sums of the weights, landmark_subtree_list marks the subtrees that contain a landmark
+			// and heaviest_child_list the heaviest child subtree without one. The subtree of the root usually holds a landmark,
+			// so the walk starts at the root whatever its own subtree holds
+			weight_list.assign(numGraphNodes_, T2(0));
+			heaviest_child_list.assign(numGraphNodes_, -1);
+			landmark_subtree_list = is_landmark_list;
+			for (const auto &v : settled_order_list) {
+				T2 lower_bound = T2(0);
+				for (int32_t i = 0; i < k; i++)
+					if ((from_distance_rows[i][root] < T2(INFINITE_WEIGHT)) && (from_distance_rows[i][v] < T2(INFINITE_WEIGHT)))
+						lower_bound = std::max(lower_bound, T2(from_distance_rows[i][v] - from_distance_rows[i][root]));
+				weight_list[v] = T2(root_distance_list[v] - lower_bound);
+			}
+			for (auto it = settled_order_list.rbegin(); it != settled_order_list.rend(); ++it) {
+				int32_t v = *it, u = parent_list[v];
+				if (u == -1)		continue;
+				weight_list[u] += weight_list[v];
+				if (landmark_subtree_list[v])		landmark_subtree_list[u] = true;
+				else if ((heaviest_child_list[u] == -1) || (weight_list[heaviest_child_list[u]] < weight_list[v]))		heaviest_child_list[u] = v;
+			}
+
+			for (landmark = root; heaviest_child_list[landmark] != -1; landmark = heaviest_child_list[landmark]);
+			if (is_landmark_list[landmark])		landmark = -1;
+		}
+
+		if (landmark == -1) {
+			// Farthest selection, also the fallback of Avoid when the walk ends on a landmark (every child subtree holds one)
+			if (k == 0) {
+				SingleSourceDistances(csr_, 0, root_distance_list, parent_list, settled_order_list, heap);
+				landmark = settled_order_list.back();
+			}
+			else {
+				T2 farthest_distance = T2(-1);
+				for (int32_t v = 0; v < numGraphNodes_; v++) {
+					if (is_landmark_list[v])		continue;
+					T2 nearest_distance = T2(INFINITE_WEIGHT);
+					for (int32_t i = 0; i < k; i++)		nearest_distance = std::min(nearest_distance, from_distance_rows[i][v]);
+					if (farthest_distance < nearest_distance) {
+						farthest_distance = nearest_distance;
+						landmark = v;
+					}
+				}
+			}
+		}
+
+		is_landmark_list[landmark] = true;
+		landmarkList_.push_back(landmark);
+		SingleSourceDistances(csr_, landmark, from_distance_rows[k], parent_list, settled_order_list, heap);
+	}
+
+	ThreadPool &thread_pool = GetThreadPool();
+	thread_pool.ParallelFor(0, num_landmarks, [&](int64_t begin_index, int64_t end_index, int32_t /*thread_id*/) {
+		IndexedHeap<T2> local_heap(numGraphNodes_);
+		std::vector<int32_t> local_parent_list, local_settled_order_list;
+		for (int64_t k = begin_index; k < end_index; k++)
+			SingleSourceDistances(reverseCsr_, landmarkList_[k], to_distance_rows[k], local_parent_list, local_settled_order_list, local_heap);
+	}, 1);
+
+	landmarkFromDistances_.assign(int64_t(numGraphNodes_) * num_landmarks, T2(INFINITE_WEIGHT));
+	landmarkToDistances_.assign(int64_t(numGraphNodes_) * num_landmarks, T2(INFINITE_WEIGHT));
+	thread_pool.ParallelFor(0, numGraphNodes_, [&](int64_t begin_index, int64_t end_index, int32_t /*thread_id*/) {
+		for (int64_t v = begin_index; v < end_index; v++)
+			for (int32_t k = 0; k < num_landmarks; k++) {
+				landmarkFromDistances_[v * num_landmarks + k] = from_distance_rows[k][v];
+				landmarkToDistances_[v * num_landmarks + k] = to_distance_rows[k][v];
+			}
+	});
+}
+
+
+// Triangle inequality bounds of every landmark L: d(v,t) >= d(L,t) - d(L,v) and d(v,t) >= d(v,L) - d(t,L). An infinite term
+// only appears when v cannot reach t, so the bound stays admissible
+template<typename T1, typename T2>
+T2 Graph<T1, T2>::LandmarkLowerBound(int32_t vertex, int32_t target_vertex) const
+{
+	int32_t num_landmarks = int32_t(landmarkList_.size());
+	const T2 *from_vertex = landmarkFromDistances_.data() + int64_t(vertex) * num_landmarks;
+	const T2 *from_target = landmarkFromDistances_.data() + int64_t(target_vertex) * num_landmarks;
+	const T2 *to_vertex = landmarkToDistances_.data() + int64_t(vertex) * num_landmarks;
+	const T2 *to_target = landmarkToDistances_.data() + int64_t(target_vertex) * num_landmarks;
+
+	T2 lower_bound = T2(0);
+	for (int32_t k = 0; k < num_landmarks; k++) {
+		T2 from_bound = from_target[k] - from_vertex[k], to_bound = to_vertex[k] - to_target[k];
+		lower_bound = (lower_bound < from_bound) ? from_bound : lower_bound;
+		lower_bound = (lower_bound < to_bound) ? to_bound : lower_bound;
+	}
+
+	return lower_bound;
+}
+
+
+// A* keyed on d(s,v) + LandmarkLowerBound(v,t). The landmark bounds are consistent, so a vertex is settled once and the query
+// stops when the target is settled, having skipped the vertices whose bound points away from the target
+template<typename T1, typename T2>
+void Graph<T1, T2>::LandmarkAStarAlgorithm(PointToPointResult<T2> &result)
+{
+	if (landmarkList_.empty())
+		throw std::logic_error("ERROR: A* with landmarks needs PreprocessLandmarks first");
+
+	int32_t start_vertex_index = result.sourceVertex_, target_vertex_index = result.targetVertex_;
+	forwardSearch_.Label(start_vertex_index, T2(0), -1);
+	forwardSearch_.heap_.Push(start_vertex_index, LandmarkLowerBound(start_vertex_index, target_vertex_index));
+
+	while (!forwardSearch_.heap_.Empty()) {
+		int32_t u = forwardSearch_.heap_.Pop();
+		++result.numSettledVertices_;
+		if (u == target_vertex_index) {
+			result.distance_ = forwardSearch_.Distance(u);
+			BuildPointToPointPath(result, u);
+			return;
+		}
+
+		for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++) {
+			int32_t v = csr_.Neighbor(e);
+			T2 new_distance = forwardSearch_.Distance(u) + csr_.Weight(e);
+			if (new_distance < forwardSearch_.Distance(v)) {
+				forwardSearch_.Label(v, new_distance, u);
+				forwardSearch_.heap_.PushOrDecreaseKey(v, new_distance + LandmarkLowerBound(v, target_vertex_index));
+			}
+		}
+	}
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::BuildContractionHierarchy()
+{
+	CommitUpdates();
+	if (HasNegativeWeights())
+		throw std::invalid_argument("ERROR: Contraction Hierarchies require non-negative edge weights");
+	contractionHierarchy_.Build(csr_, T2(INFINITE_WEIGHT));
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::SaveContractionHierarchy(const std::string &file_name) const
+{
+	if (contractionHierarchy_.Empty())
+		throw std::logic_error("ERROR: There is no Contraction Hierarchy to save, BuildContractionHierarchy first");
+	contractionHierarchy_.Save(file_name);
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::LoadContractionHierarchy(const std::string &file_name)
+{
+	CommitUpdates();
+	contractionHierarchy_.Load(file_name);
+	if (contractionHierarchy_.NumVertices() != numGraphNodes_) {
+		contractionHierarchy_.Clear();
+		throw std::runtime_error("ERROR: The Contraction Hierarchy in " + file_name + " does not match the number of Graph nodes");
+	}
+}
+
+
+// Bidirectional Dijkstra restricted to the upward edges of the hierarchy: every shortest path has a highest ranked vertex that
+// both searches reach upwards. A search direction stops once its heap top reaches mu, the best meeting distance so far. The path
+// through the meeting vertex is made of shortcuts, which the hierarchy unpacks into original edges
+template<typename T1, typename T2>
+void Graph<T1, T2>::ContractionHierarchyAlgorithm(PointToPointResult<T2> &result)
+{
+	if (contractionHierarchy_.NumVertices() != numGraphNodes_)
+		throw std::logic_error("ERROR: Contraction Hierarchy queries need BuildContractionHierarchy or LoadContractionHierarchy first");
+
+	int32_t start_vertex_index = result.sourceVertex_, target_vertex_index = result.targetVertex_;
+	forwardSearch_.Label(start_vertex_index, T2(0), -1);
+	forwardSearch_.heap_.Push(start_vertex_index, T2(0));
+	backwardSearch_.Label(target_vertex_index, T2(0), -1);
+	backwardSearch_.heap_.Push(target_vertex_index, T2(0));
+
+	T2 mu = T2(INFINITE_WEIGHT);
+	int32_t meeting_vertex = -1;
+	while (true) {
+		bool FORWARD_ACTIVE_COND = (!forwardSearch_.heap_.Empty()) && (forwardSearch_.heap_.TopKey() < mu);
+		bool BACKWARD_ACTIVE_COND = (!backwardSearch_.heap_.Empty()) && (backwardSearch_.heap_.TopKey() < mu);
+		if ((!FORWARD_ACTIVE_COND) && (!BACKWARD_ACTIVE_COND))		break;
+
+		bool FORWARD_SEARCH_COND = (FORWARD_ACTIVE_COND) && ((!BACKWARD_ACTIVE_COND) || (!(backwardSearch_.heap_.TopKey() < forwardSearch_.heap_.TopKey())));
+		SearchSpace<T2> &search = FORWARD_SEARCH_COND ? forwardSearch_ : backwardSearch_;
+		SearchSpace<T2> &opposite_search = FORWARD_SEARCH_COND ? backwardSearch_ : forwardSearch_;
+		const CSRGraph<T2> &csr = FORWARD_SEARCH_COND ? contractionHierarchy_.UpwardGraph() : contractionHierarchy_.DownwardGraph();
+
+		int32_t u = search.heap_.Pop();
+		++result.numSettledVertices_;
+		if ((opposite_search.Reached(u)) && (search.Distance(u) + opposite_search.Distance(u) < mu)) {
+			mu = search.Distance(u) + opposite_search.Distance(u);
+			meeting_vertex = u;
+		}
+
+		for (int64_t e = csr.EdgeBegin(u); e < csr.EdgeEnd(u); e++) {
+			int32_t v = csr.Neighbor(e);
+			T2 new_distance = search.Distance(u) + csr.Weight(e);
+			if (new_distance < search.Distance(v)) {
+				search.Label(v, new_distance, u);
+				search.heap_.PushOrDecreaseKey(v, new_distance);
+			}
+		}
+	}
+
+	if (meeting_vertex == -1)		return;
+	result.distance_ = mu;
+
+	BuildPointToPointPath(result, meeting_vertex);
+	std::vector<int32_t> shortcut_path_list;
+	shortcut_path_list.swap(result.path_);
+	result.path_.push_back(start_vertex_index);
+	for (size_t i = 0; i + 1 < shortcut_path_list.size(); i++)
+		contractionHierarchy_.UnpackEdge(shortcut_path_list[i], shortcut_path_list[i + 1], result.path_);
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::AllPairsShortestPath(AllPairsShortestPathResult<T2> &result, int32_t flag)
+{
+	if ((flag != 0) && (flag != 1))
+		throw std::invalid_argument("ERROR: Flag " + std::to_string(flag) + " is not an All-To-All Shortest Path algorithm");
+
+	CommitUpdates();
+	result.numVertices_ = numGraphNodes_;
+	if (flag == 0) {
+		ComputeAllPairsDistanceMatrix(result.distances_);
+		return;
+	}
+
+	// resize keeps the allocation of a matrix that already has V x V entries, and every row is overwritten by its source
+	result.distances_.resize(int64_t(numGraphNodes_) * numGraphNodes_);
+	T2 *distance_matrix = result.distances_.data();
+	JohnsonAlgorithm([&](int32_t source_vertex, const std::vector<T2> &distance_list) {
+		std::copy(distance_list.begin(), distance_list.end(), distance_matrix + int64_t(source_vertex) * numGraphNodes_);
+	});
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::AllPairsShortestPath(const std::function<void(int32_t, const std::vector<T2>&)> &callback)
+{
+	CommitUpdates();
+	JohnsonAlgorithm(callback);
+}
+
+
+// Johnson's algorithm: potentials h from one Bellman-Ford run make every edge weight w(u,v) + h(u) - h(v) non-negative without
+// changing which paths are shortest, so a heap Dijkstra from every source solves the all-pairs problem in O(V (V+E) log V), far
+// below the O(V^3) of WFI on sparse graphs. The Dijkstra runs are a BatchDijkstraAlgorithm over all the vertices, and
+// d(s,v) = d'(s,v) - h(s) + h(v) is restored before the row is handed to the callback
+template<typename T1, typename T2>
+void Graph<T1, T2>::JohnsonAlgorithm(const std::function<void(int32_t, const std::vector<T2>&)> &callback)
+{
+	std::vector<T2> potential_list;
+	bool REWEIGHT_COND = ComputeJohnsonPotentials(potential_list);
+
+	CSRGraph<T2> reweighted_csr;
+	if (REWEIGHT_COND) {
+		std::vector<int64_t> offsets(numGraphNodes_ + 1, csr_.NumEdges());
+		std::vector<int32_t> neighbors(csr_.NumEdges());
+		std::vector<T2> weights(csr_.NumEdges());
+		for (int32_t u = 0; u < numGraphNodes_; u++) {
+			offsets[u] = csr_.EdgeBegin(u);
+			for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++) {
+				neighbors[e] = csr_.Neighbor(e);
+				weights[e] = csr_.Weight(e) + potential_list[u] - potential_list[csr_.Neighbor(e)];
+			}
+		}
+		reweighted_csr = CSRGraph<T2>(offsets, neighbors, weights);
+	}
+	const CSRGraph<T2> &csr = REWEIGHT_COND ? reweighted_csr : csr_;
+
+	std::vector<int32_t> source_list(numGraphNodes_);
+	for (int32_t i = 0; i < numGraphNodes_; i++)		source_list[i] = i;
+
+	BatchDijkstraAlgorithm(csr, source_list, [&](ShortestPathResult<T2> &result, const std::vector<int32_t> &settled_order_list, int32_t /*thread_id*/) {
+		if (REWEIGHT_COND)
+			for (const auto &v : settled_order_list)
+				result.distances_[v] = result.distances_[v] - potential_list[result.sourceVertex_] + potential_list[v];
+		callback(result.sourceVertex_, result.distances_);
+	});
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::MultiSourceShortestPath(const std::vector<int32_t> &source_list, const std::function<void(const ShortestPathResult<T2>&, int32_t)> &callback)
+{
+	CommitUpdates();
+	for (const auto &elem : source_list)
+		if ((elem < 0) || (elem >= numGraphNodes_))
+			throw std::out_of_range("ERROR: Start vertex index " + std::to_string(elem) + " is out of range");
+	if (HasNegativeWeights())
+		throw std::invalid_argument("ERROR: Multi-source Dijkstra requires non-negative edge weights, use Johnson for all the sources");
+
+	BatchDijkstraAlgorithm(csr_, source_list, [&](ShortestPathResult<T2> &result, const std::vector<int32_t> &/*settled_order_list*/, int32_t thread_id) {
+		callback(result, thread_id);
+	});
+}
+
+
+// Dijkstra from every source of source_list on the thread pool, the sources being claimed one at a time so that sources with
+// large search spaces do not stall the other threads. csr is only read. Every thread owns one result, heap and settled list,
+// allocated once for the whole batch: the labels are INFINITE_WEIGHT/-1 between two sources, and only the vertices settled by
+// a source are reset after its callback, so a source costs O(vertices reached + edges scanned) rather than O(V)
+template<typename T1, typename T2>
+void Graph<T1, T2>::BatchDijkstraAlgorithm(const CSRGraph<T2> &csr, const std::vector<int32_t> &source_list, const std::function<void(ShortestPathResult<T2>&, const std::vector<int32_t>&, int32_t)> &callback)
+{
+	ThreadPool &thread_pool = GetThreadPool();
+	int32_t num_threads = thread_pool.NumThreads();
+	std::vector<ShortestPathResult<T2> > result_list(num_threads);
+	std::vector<IndexedHeap<T2> > heap_list(num_threads);
+	std::vector<std::vector<int32_t> > settled_order_lists(num_threads);
+
+	thread_pool.Run([&](int32_t thread_id) {
+		result_list[thread_id].distances_.assign(numGraphNodes_, T2(INFINITE_WEIGHT));
+		result_list[thread_id].predecessors_.assign(numGraphNodes_, -1);
+		heap_list[thread_id].Resize(numGraphNodes_);
+	});
+
+	thread_pool.ParallelFor(0, int64_t(source_list.size()), [&](int64_t begin_index, int64_t end_index, int32_t thread_id) {
+		ShortestPathResult<T2> &result = result_list[thread_id];
+		std::vector<T2> &distance_list = result.distances_;
+		std::vector<int32_t> &predecessor_list = result.predecessors_;
+		std::vector<int32_t> &settled_order_list = settled_order_lists[thread_id];
+		IndexedHeap<T2> &heap = heap_list[thread_id];
+
+		for (int64_t i = begin_index; i < end_index; i++) {
+			int32_t start_vertex_index = source_list[i];
+			result.sourceVertex_ = start_vertex_index;
+			distance_list[start_vertex_index] = T2(0);
+			heap.Push(start_vertex_index, T2(0));
+			while (!heap.Empty()) {
+				int32_t u = heap.Pop();
+				settled_order_list.push_back(u);
+				for (int64_t e = csr.EdgeBegin(u); e < csr.EdgeEnd(u); e++) {
+					int32_t v = csr.Neighbor(e);
+					if (distance_list[u] + csr.Weight(e) < distance_list[v]) {
+						distance_list[v] = distance_list[u] + csr.Weight(e);
+						predecessor_list[v] = u;
+						heap.PushOrDecreaseKey(v, distance_list[v]);
+					}
+				}
+			}
+			result.numIterations_ = int64_t(settled_order_list.size());
+
+			callback(result, settled_order_list, thread_id);
+
+			for (const auto &v : settled_order_list) {
+				distance_list[v] = T2(INFINITE_WEIGHT);
+				predecessor_list[v] = -1;
+			}
+			settled_order_list.clear();
+		}
+	}, 1);
+}
+
+
+// Bellman-Ford from a virtual source joined to every vertex by a zero weight edge, i.e. all the vertices start queued at distance 0.
+// Returns false, with all potentials 0, when no edge is negative. Throws on a negative cycle, found as in FordAlgorithm
+template<typename T1, typename T2>
+bool Graph<T1, T2>::ComputeJohnsonPotentials(std::vector<T2> &potential_list)
+{
+	potential_list.assign(numGraphNodes_, T2(0));
+	if (!HasNegativeWeights())		return false;
+
+	std::vector<int32_t> predecessor_list(numGraphNodes_, -1), path_length_list(numGraphNodes_, 0), cycle_node_list;
+	std::vector<bool> in_queue_bitset(numGraphNodes_, true);
+	std::deque<int32_t> node_index_queue;
+	for (int32_t i = 0; i < numGraphNodes_; i++)		node_index_queue.push_back(i);
+
+	while (!node_index_queue.empty()) {
+		int32_t u = node_index_queue.front();
+		node_index_queue.pop_front();
+		in_queue_bitset[u] = false;
+
+		for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++) {
+			int32_t v = csr_.Neighbor(e);
+			if (potential_list[u] + csr_.Weight(e) < potential_list[v]) {
+				potential_list[v] = potential_list[u] + csr_.Weight(e);
+				predecessor_list[v] = u;
+				path_length_list[v] = path_length_list[u] + 1;
+
+				if ((path_length_list[v] >= numGraphNodes_) && (FindPredecessorCycle(predecessor_list, v, cycle_node_list)))
+					throw std::invalid_argument("ERROR: All-To-All shortest paths require a Graph without negative cycles");
+
+				if (!in_queue_bitset[v]) {
+					in_queue_bitset[v] = true;
+					node_index_queue.push_back(v);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+
+// Blocked Floyd-Warshall on one contiguous row-major V x V matrix. For every diagonal tile K:
+//   Phase 1: the diagonal tile (K,K) is updated with itself
+//   Phase 2: the tiles of row K and column K are updated with the diagonal tile, independently of each other
+//   Phase 3: every remaining tile (I,J) is updated with the tiles (I,K) and (K,J), independently of each other
+// Phase 2 and Phase 3 tiles run on the thread pool, and the inner loop is the vectorized min-plus row update.
+// Negative edge weights are fine, a negative cycle is rejected first by the Bellman-Ford of Johnson's potentials: WFI would
+// only report it as a negative diagonal entry after driving the distances around the cycle towards overflow
+template<typename T1, typename T2>
+void Graph<T1, T2>::ComputeAllPairsDistanceMatrix(std::vector<T2> &distance_matrix)
+{
+	std::vector<T2> potential_list;
+	ComputeJohnsonPotentials(potential_list);
+
+	int64_t num_nodes = numGraphNodes_;
+	distance_matrix.assign(num_nodes * num_nodes, T2(INFINITE_WEIGHT));
+	for (int32_t i = 0; i < numGraphNodes_; i++) {
+		for (int64_t e = csr_.EdgeBegin(i); e < csr_.EdgeEnd(i); e++)
+			if (csr_.Weight(e) < distance_matrix[i * num_nodes + csr_.Neighbor(e)])
+				distance_matrix[i * num_nodes + csr_.Neighbor(e)] = csr_.Weight(e);
+		distance_matrix[i * num_nodes + i] = T2(0);
+	}
+
+	int32_t num_tiles = (numGraphNodes_ + WFI_TILE_SIZE - 1) / WFI_TILE_SIZE;
+	ThreadPool &thread_pool = GetThreadPool();
+	for (int32_t k = 0; k < num_tiles; k++) {
+		UpdateWFITile(distance_matrix, k, k, k);
+
+		thread_pool.ParallelFor(0, 2 * num_tiles, [&](int64_t begin_index, int64_t end_index, int32_t /*thread_id*/) {
+			for (int64_t t = begin_index; t < end_index; t++) {
+				int32_t tile_index = int32_t(t / 2);
+				if (tile_index == k)		continue;
+				if (t % 2 == 0)		UpdateWFITile(distance_matrix, k, tile_index, k);
+				else UpdateWFITile(distance_matrix, tile_index, k, k);
+			}
+		}, 1);
+
+		thread_pool.ParallelFor(0, int64_t(num_tiles) * num_tiles, [&](int64_t begin_index, int64_t end_index, int32_t /*thread_id*/) {
+			for (int64_t t = begin_index; t < end_index; t++) {
+				int32_t tile_row = int32_t(t / num_tiles), tile_column = int32_t(t % num_tiles);
+				if ((tile_row != k) && (tile_column != k))
+					UpdateWFITile(distance_matrix, tile_row, tile_column, k);
+			}
+		}, 1);
+	}
+}
+
+
+// Relaxes the tile (tile_row, tile_column) through the intermediate vertices of the tile tile_k
+template<typename T1, typename T2>
+void Graph<T1, T2>::UpdateWFITile(std::vector<T2> &distance_matrix, int32_t tile_row, int32_t tile_column, int32_t tile_k)
+{
+	int64_t num_nodes = numGraphNodes_;
+	int32_t row_begin = tile_row * WFI_TILE_SIZE, row_end = std::min(row_begin + WFI_TILE_SIZE, numGraphNodes_);
+	int32_t column_begin = tile_column * WFI_TILE_SIZE, column_end = std::min(column_begin + WFI_TILE_SIZE, numGraphNodes_);
+	int32_t k_begin = tile_k * WFI_TILE_SIZE, k_end = std::min(k_begin + WFI_TILE_SIZE, numGraphNodes_);
+
+	T2 *matrix = distance_matrix.data();
+	for (int32_t k = k_begin; k < k_end; k++)
+		for (int32_t i = row_begin; i < row_end; i++) {
+			T2 distance_ik = matrix[i * num_nodes + k];
+			if ((i == k) || (!(distance_ik < T2(INFINITE_WEIGHT))))		continue;
+			MinPlusRowUpdate(matrix + i * num_nodes + column_begin, matrix + k * num_nodes + column_begin, distance_ik, T2(INFINITE_WEIGHT), column_end - column_begin);
+		}
+}
+
+
+// Delta-Stepping (Meyer and Sanders): the tentative distances are kept in buckets of width Delta. The lowest non-empty bucket is
+// settled in phases: its light edges (weight <= Delta) are relaxed in parallel until the bucket stops refilling, then the heavy
+// edges of every vertex removed from the bucket are relaxed once in parallel. Distances are lowered with an atomic compare-and-swap,
+// the relaxation requests of every thread go to a thread local buffer and are merged into the buckets after each parallel step.
+// A queued distance is below the current bucket plus the largest weight, so max_weight / Delta + 2 buckets reused cyclically hold
+// all of them. The predecessors are rebuilt from the final distances
+template<typename T1, typename T2>
+template<typename Tracer>
+void Graph<T1, T2>::DeltaSteppingAlgorithm(ShortestPathResult<T2> &result, int32_t start_vertex_index, Tracer &tracer)
+{
+	if (HasNegativeWeights())
+		throw std::invalid_argument("ERROR: Delta-Stepping requires non-negative edge weights");
+
+	InitShortestPathResult(result, start_vertex_index);
+	std::vector<T2> &result_distance_list = result.distances_;
+	std::vector<int32_t> &predecessor_list = result.predecessors_;
+
+	T2 delta = deltaStepWidth_, max_weight = T2(0);
+	double total_weight = 0;		// A sum of int32_t weights overflows T2
+	for (int64_t e = 0; e < csr_.NumEdges(); e++) {
+		total_weight += double(csr_.Weight(e));
+		if (max_weight < csr_.Weight(e))		max_weight = csr_.Weight(e);
+	}
+	if ((!(delta > T2(0))) && (csr_.NumEdges() > 0))		delta = T2(total_weight / double(csr_.NumEdges()));
+	if (!(delta > T2(0)))		delta = T2(1);
+
+	std::vector<std::atomic<T2> > distance_list(numGraphNodes_);
+	for (int32_t i = 0; i < numGraphNodes_; i++)		distance_list[i].store(result_distance_list[i], std::memory_order_relaxed);
+
+	ThreadPool &thread_pool = GetThreadPool();
+	std::vector<std::vector<int32_t> > local_request_lists(thread_pool.NumThreads());
+	// (v, u, d): the relaxation of u-->v lowered the distance of v to d, kept for the predecessors of the label snapshots only
+	std::vector<std::vector<std::tuple<int32_t, int32_t, T2> > > local_label_lists(thread_pool.NumThreads());
+	std::vector<std::vector<int32_t> > buckets(size_t(max_weight / delta) + 2);
+	buckets[0].push_back(start_vertex_index);
+	int64_t num_bucket_entries = 1;
+	std::vector<int64_t> bucket_stamp_list(numGraphNodes_, -1), removed_stamp_list(numGraphNodes_, -1);
+	int64_t stamp = 0;
+
+	// Relaxes the light (weight <= delta) or the heavy (weight > delta) edges of the vertices in the frontier
+	std::vector<int32_t> frontier;
+	bool RELAX_LIGHT_EDGES_COND = true;
+	std::function<void(int64_t, int64_t, int32_t)> relax_edges = [&](int64_t begin_index, int64_t end_index, int32_t thread_id) {
+		for (int64_t i = begin_index; i < end_index; i++) {
+			int32_t u = frontier[i];
+			T2 u_distance = distance_list[u].load(std::memory_order_relaxed);
+			for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++) {
+				if ((csr_.Weight(e) <= delta) != RELAX_LIGHT_EDGES_COND)		continue;
+
+				int32_t v = csr_.Neighbor(e);
+				T2 new_distance = u_distance + csr_.Weight(e);
+				T2 v_distance = distance_list[v].load(std::memory_order_relaxed);
+				while (new_distance < v_distance)
+					if (distance_list[v].compare_exchange_weak(v_distance, new_distance, std::memory_order_relaxed)) {
+						local_request_lists[thread_id].push_back(v);
+						if (Tracer::LABEL_SNAPSHOTS)		local_label_lists[thread_id].push_back(std::make_tuple(v, u, new_distance));
+						break;
+					}
+			}
+		}
+	};
+
+	// Moves the vertices whose distance was lowered to the bucket of their new distance
+	std::function<void()> merge_requests = [&]() {
+		++stamp;
+		for (auto &elem : local_request_lists) {
+			for (const auto &v : elem) {
+				if (bucket_stamp_list[v] == stamp)		continue;
+				bucket_stamp_list[v] = stamp;
+
+				size_t bucket_index = size_t(distance_list[v].load(std::memory_order_relaxed) / delta);
+				buckets[bucket_index % buckets.size()].push_back(v);
+				++num_bucket_entries;
+			}
+			elem.clear();
+		}
+	};
+
+	int32_t count = 0;
+	for (size_t current_bucket = 0; num_bucket_entries > 0; current_bucket++) {
+		std::vector<int32_t> &bucket = buckets[current_bucket % buckets.size()];
+		if (bucket.empty())		continue;
+
+		std::vector<int32_t> removed_node_list;
+		while (!bucket.empty()) {
+			frontier.clear();
+			frontier.swap(bucket);
+			num_bucket_entries -= frontier.size();
+			frontier.erase(std::remove_if(frontier.begin(), frontier.end(), [&](int32_t v) {
+				return size_t(distance_list[v].load(std::memory_order_relaxed) / delta) != current_bucket; }), frontier.end());
+			for (const auto &v : frontier)
+				if (removed_stamp_list[v] != int64_t(current_bucket)) {
+					removed_stamp_list[v] = current_bucket;
+					removed_node_list.push_back(v);
+				}
+
+			RELAX_LIGHT_EDGES_COND = true;
+			thread_pool.ParallelFor(0, frontier.size(), relax_edges, 256);
+			merge_requests();
+		}
+
+		frontier.swap(removed_node_list);
+		RELAX_LIGHT_EDGES_COND = false;
+		thread_pool.ParallelFor(0, frontier.size(), relax_edges, 256);
+		merge_requests();
+
+		++count;
+		if (Tracer::LABEL_SNAPSHOTS) {
+			for (int32_t i = 0; i < numGraphNodes_; i++)		result_distance_list[i] = distance_list[i].load(std::memory_order_relaxed);
+			for (auto &elem : local_label_lists) {
+				for (const auto &label : elem)
+					if (std::get<2>(label) == result_distance_list[std::get<0>(label)])		predecessor_list[std::get<0>(label)] = std::get<1>(label);
+				elem.clear();
+			}
+			tracer.Iteration(count, result);
+		}
+	}
+
+	// Matching every label with the relaxation that set it can close a cycle of zero weight edges, a BFS over the tight edges
+	// u-->v with d(u) + w = d(v) cannot
+	for (int32_t i = 0; i < numGraphNodes_; i++)		result_distance_list[i] = distance_list[i].load(std::memory_order_relaxed);
+	BuildShortestPathTree(result);
+	result.numIterations_ = count;
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::MinimumSpanningTree(std::vector<std::string> &mst_adjacency_matrix, int32_t flag)
+{
+	CommitUpdates();
+	mst_adjacency_matrix = {};
+
+	SpanningTreeResult<T2> result;
+	MinimumSpanningTree(result, flag);
+	GraphPrinter<T1, T2>::WriteSpanningTree(*this, result, mst_adjacency_matrix);
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::MinimumSpanningTree(SpanningTreeResult<T2> &result, int32_t flag)
+{
+	CommitUpdates();
+	std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &mst_edges_list = result.edges_;
+	mst_edges_list.clear();
+
+	switch (flag)
+	{
+	case 0:
+		KruskalAlgorithm(mst_edges_list);
+		break;
+
+	case 1:
+	case 2:
+		PrimAlgorithm(mst_edges_list);
+		break;
+
+	case 3:
+		BoruvkaAlgorithm(mst_edges_list);
+		break;
+
+	default:
+		throw std::invalid_argument("ERROR: Flag " + std::to_string(flag) + " is not a Minimum Spanning Tree algorithm");
+	}
+
+	result.totalWeight_ = T2(0);
+	for (const auto &elem : mst_edges_list)		result.totalWeight_ += elem.first;
+}
+
+
+// Scans the edges in increasing order of weight and keeps every edge whose end vertices are still in different trees of the
+// forest built so far. The trees are tracked with a disjoint set, so the cost is O(E log E) for the sort plus O(E alpha(V))
+// for the scan. The edges are treated as undirected and a minimum spanning forest is returned for a disconnected graph
+template<typename T1, typename T2>
+void Graph<T1, T2>::KruskalAlgorithm(std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &mst_edges_list)
+{
+	std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > edges_list;
+	GenerateEdgesList(edges_list);
+	std::sort(edges_list.begin(), edges_list.end());
+
+	DisjointSet components(numGraphNodes_);
+	mst_edges_list.reserve((numGraphNodes_ > 0) ? numGraphNodes_ - 1 : 0);
+	for (size_t i = 0; (i < edges_list.size()) && (components.NumSets() > 1); i++)
+		if (components.Union(edges_list[i].second.first, edges_list[i].second.second))
+			mst_edges_list.push_back(edges_list[i]);
+}
+
+
+// Grows every tree of the forest from its lowest unvisited vertex, always adding the lightest edge that connects the tree to a
+// new vertex. The candidate edge weight of every vertex outside the tree is kept in an indexed heap and lowered with DecreaseKey,
+// so the cost is O(E log V). The edges are treated as undirected: both the out-edges (csr_) and the in-edges (reverseCsr_) of a
+// vertex are scanned, and every MST edge is reported in its stored direction
+template<typename T1, typename T2>
+void Graph<T1, T2>::PrimAlgorithm(std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &mst_edges_list)
+{
+	IndexedHeap<T2> heap(numGraphNodes_);
+	std::vector<bool> in_tree_list(numGraphNodes_, false);
+	std::vector<std::pair<int32_t, int32_t> > tree_edge_list(numGraphNodes_, std::pair<int32_t, int32_t>(-1, -1));	// Node_Index --> (Start, End) of its candidate edge
+	mst_edges_list.reserve((numGraphNodes_ > 0) ? numGraphNodes_ - 1 : 0);
+
+	for (int32_t root = 0; root < numGraphNodes_; root++) {
+		if (in_tree_list[root])		continue;
+
+		heap.Push(root, T2(0));
+		while (!heap.Empty()) {
+			T2 weight = heap.TopKey();
+			int32_t u = heap.Pop();
+			in_tree_list[u] = true;
+			if (u != root)
+				mst_edges_list.push_back(std::pair<T2, std::pair<int32_t, int32_t> >(weight, tree_edge_list[u]));
+
+			for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++) {
+				int32_t v = csr_.Neighbor(e);
+				if ((in_tree_list[v]) || ((heap.Contains(v)) && (!(csr_.Weight(e) < heap.Key(v)))))		continue;
+				heap.PushOrDecreaseKey(v, csr_.Weight(e));
+				tree_edge_list[v] = std::pair<int32_t, int32_t>(u, v);
+			}
+			for (int64_t e = reverseCsr_.EdgeBegin(u); e < reverseCsr_.EdgeEnd(u); e++) {
+				int32_t v = reverseCsr_.Neighbor(e);
+				if ((in_tree_list[v]) || ((heap.Contains(v)) && (!(reverseCsr_.Weight(e) < heap.Key(v)))))		continue;
+				heap.PushOrDecreaseKey(v, reverseCsr_.Weight(e));
+				tree_edge_list[v] = std::pair<int32_t, int32_t>(v, u);
+			}
+		}
+	}
+}
+
+
+// Boruvka on numThreads_ threads. Every round finds in parallel the lightest edge leaving every component (ties broken by the edge
+// index, so that the chosen edges can never close a cycle), then merges the components along those edges with a concurrent
+// union-find; the edges whose union succeeds join the forest. Every round at least halves the number of components that still
+// have an outgoing edge, so there are at most log2(V) rounds, and the edges that became internal to a component are dropped
+// after every round. The edges are treated as undirected and a minimum spanning forest is returned for a disconnected graph
+template<typename T1, typename T2>
+void Graph<T1, T2>::BoruvkaAlgorithm(std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &mst_edges_list)
+{
+	ThreadPool &thread_pool = GetThreadPool();
+	int32_t num_threads = thread_pool.NumThreads();
+
+	std::vector<int32_t> edge_source_list(csr_.NumEdges());
+	thread_pool.ParallelFor(0, numGraphNodes_, [&](int64_t begin_index, int64_t end_index, int32_t /*thread_id*/) {
+		for (int32_t u = int32_t(begin_index); u < int32_t(end_index); u++)
+			for (int64_t e = csr_.EdgeBegin(u); e < csr_.EdgeEnd(u); e++)		edge_source_list[e] = u;
+	});
+
+	std::vector<int64_t> active_edge_list;
+	active_edge_list.reserve(csr_.NumEdges());
+	for (int64_t e = 0; e < csr_.NumEdges(); e++)
+		if (edge_source_list[e] != csr_.Neighbor(e))		active_edge_list.push_back(e);
+
+	ConcurrentDisjointSet components(numGraphNodes_);
+	std::vector<std::atomic<int64_t> > lightest_edge_list(numGraphNodes_);		// Component root --> Lightest outgoing edge, -1 if none
+	for (auto &elem : lightest_edge_list)		elem.store(-1, std::memory_order_relaxed);
+	std::vector<std::vector<int64_t> > local_edge_lists(num_threads), local_tree_edge_lists(num_threads);
+
+	auto lighter_edge = [&](int64_t edge_1, int64_t edge_2) {
+		return (csr_.Weight(edge_1) < csr_.Weight(edge_2)) || ((!(csr_.Weight(edge_2) < csr_.Weight(edge_1))) && (edge_1 < edge_2));
+	};
+	auto offer_edge = [&](int32_t root, int64_t edge) {
+		int64_t current_edge = lightest_edge_list[root].load(std::memory_order_relaxed);
+		while ((current_edge == -1) || (lighter_edge(edge, current_edge)))
+			if (lightest_edge_list[root].compare_exchange_weak(current_edge, edge, std::memory_order_relaxed))		break;
+	};
+
+	std::vector<int32_t> root_list;
+	while (!active_edge_list.empty()) {
+		// Drop the edges inside a component and offer the others to the components at both of their ends
+		thread_pool.ParallelFor(0, active_edge_list.size(), [&](int64_t begin_index, int64_t end_index, int32_t thread_id) {
+			for (int64_t i = begin_index; i < end_index; i++) {
+				int64_t e = active_edge_list[i];
+				int32_t root_u = components.Find(edge_source_list[e]), root_v = components.Find(csr_.Neighbor(e));
+				if (root_u == root_v)		continue;
+
+				local_edge_lists[thread_id].push_back(e);
+				offer_edge(root_u, e);
+				offer_edge(root_v, e);
+			}
+		}, 4096);
+
+		active_edge_list.clear();
+		for (auto &elem : local_edge_lists) {
+			active_edge_list.insert(active_edge_list.end(), elem.begin(), elem.end());
+			elem.clear();
+		}
+		if (active_edge_list.empty())		break;
+
+		root_list.clear();
+		for (int32_t u = 0; u < numGraphNodes_; u++)
+			if (lightest_edge_list[u].load(std::memory_order_relaxed) != -1)		root_list.push_back(u);
+
+		// Merge every component with the component at the other end of its lightest edge
+		thread_pool.ParallelFor(0, root_list.size(), [&](int64_t begin_index, int64_t end_index, int32_t thread_id) {
+			for (int64_t i = begin_index; i < end_index; i++) {
+				int64_t e = lightest_edge_list[root_list[i]].exchange(-1, std::memory_order_relaxed);
+				if (components.Union(edge_source_list[e], csr_.Neighbor(e)))		local_tree_edge_lists[thread_id].push_back(e);
+			}
+		}, 256);
+	}
+
+	std::vector<int64_t> tree_edge_list;
+	for (const auto &elem : local_tree_edge_lists)		tree_edge_list.insert(tree_edge_list.end(), elem.begin(), elem.end());
+	std::sort(tree_edge_list.begin(), tree_edge_list.end(), lighter_edge);
+
+	mst_edges_list.reserve(tree_edge_list.size());
+	for (const auto &e : tree_edge_list)
+		mst_edges_list.push_back(std::pair<T2, std::pair<int32_t, int32_t> >(csr_.Weight(e), std::pair<int32_t, int32_t>(edge_source_list[e], csr_.Neighbor(e))));
+}
+
+
+template<typename T1, typename T2>
+void Graph<T1, T2>::GenerateEdgesList(std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > &edges_list)
+{
+	edges_list.reserve(csr_.NumEdges());
+	for (int32_t i = 0; i < numGraphNodes_; i++)
+		for (int64_t e = csr_.EdgeBegin(i); e < csr_.EdgeEnd(i); e++)
+			edges_list.push_back(std::pair<T2, std::pair<int32_t, int32_t> >(csr_.Weight(e), std::pair<int32_t, int32_t>(i, csr_.Neighbor(e))));
 }
 
 #endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_H
\ No newline at end of file
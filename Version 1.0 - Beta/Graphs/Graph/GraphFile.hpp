@@ -0,0 +1,74 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// GraphFile.hpp: Contains the layout of the binary Graph file
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHFILE_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHFILE_H
+
+#include "MappedArray.hpp"
+
+#include <memory>
+
+#include <stdint.h>
+
+// Binary Graph file, written by Graph::SaveGraphFile and mapped by the Graph(file_name) constructor.
+// The fixed size header is followed by the sections below, each one a raw array starting at a 64 byte aligned offset, so the
+// mapped sections are used in place as the CSR arrays and the node tables of the Graph, without any parsing:
+//
+//   FORWARD_OFFSETS     int64_t[V + 1]     out-edges CSR (csr_)
+//   FORWARD_NEIGHBORS   int32_t[E]
+//   FORWARD_WEIGHTS     T2[E]
+//   REVERSE_OFFSETS     int64_t[V + 1]     in-edges CSR (reverseCsr_)
+//   REVERSE_NEIGHBORS   int32_t[E]
+//   REVERSE_WEIGHTS     T2[E]
+//   NODE_INDEX_TABLE    (uuid, index)[V]   sorted by uuid, as std::pair<int64_t, int32_t>
+//   NODES               Node<T1>[V]        uuid and payload of every node
+//
+// The arrays are stored in the byte order and layout of the machine that wrote them; endianTag_ and the element sizes in the
+// header reject a file from an incompatible machine or Graph type. Files of an older version are rejected, not converted
+struct GraphFileHeader {
+	enum Section { FORWARD_OFFSETS = 0, FORWARD_NEIGHBORS, FORWARD_WEIGHTS, REVERSE_OFFSETS, REVERSE_NEIGHBORS, REVERSE_WEIGHTS, NODE_INDEX_TABLE, NODES, NUM_SECTIONS };
+
+	static const uint32_t VERSION = 1;
+	static const uint32_t ENDIAN_TAG = 0x01020304;
+	static const uint64_t SECTION_ALIGNMENT = 64;
+
+	char magic_[8];		// "GRAPHCSR"
+	uint32_t version_;
+	uint32_t endianTag_;
+	uint32_t nodeSize_;		// sizeof(Node<T1>)
+	uint32_t weightSize_;		// sizeof(T2)
+	int64_t numVertices_;
+	int64_t numEdges_;
+	uint64_t sectionOffsets_[NUM_SECTIONS];		// Byte offset of every section from the start of the file
+	uint64_t sectionSizes_[NUM_SECTIONS];		// Byte size of every section
+};
+
+
+// View of one section of a mapped Graph file, whose bounds the caller has checked against the file size
+template<typename T>
+MappedArray<T> MapGraphFileSection(const std::shared_ptr<const MappedFile> &file, const GraphFileHeader &header, int32_t section)
+{
+	return MappedArray<T>(file, reinterpret_cast<const T *>(file->Data() + header.sectionOffsets_[section]), size_t(header.sectionSizes_[section] / sizeof(T)));
+}
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHFILE_H
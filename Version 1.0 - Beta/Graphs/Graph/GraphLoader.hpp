@@ -0,0 +1,456 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// GraphLoader.hpp: Contains the declaration and definition of different data members and methods of the GraphLoader class
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHLOADER_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHLOADER_H
+
+#include "Node.hpp"
+#include "CSRGraph.hpp"
+#include "MappedArray.hpp"
+#include "ThreadPool.hpp"
+
+#include <vector>
+#include <string>
+#include <atomic>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <cmath>
+#include <cctype>
+#include <limits>
+
+#include <stdint.h>
+
+// Parallel loader of text graphs into the node list and the CSR of a Graph, without the dense matrix in between.
+// The file is mapped and cut into chunks at line boundaries, and the threads parse the chunks with a hand written number
+// parser. The text is scanned once per stage: collect the uuids (edge lists only), count the out-degrees, scatter the edges
+// into the CSR arrays. Nothing but the final CSR and O(V) tables per thread is held in memory, the edges are never buffered.
+// Edge list uuids are arbitrary int64 values, remapped to dense ids in increasing uuid order
+template<typename T1, typename T2>
+class GraphLoader {
+private:
+	int32_t numThreads_;
+	std::vector<Node<T1> > nodes_;
+	CSRGraph<T2> csr_;
+
+	struct TextEdge {
+		int64_t u_, v_;		// uuids as written in the file
+		T2 weight_;
+	};
+
+	static const int64_t CHUNK_SIZE = 16 << 20;		// Bytes of text per chunk, a few chunks per thread keep the threads balanced
+	static const size_t EDGE_BATCH_SIZE = 256;		// Edges parsed before their uuids are looked up, so the lookups overlap their cache misses
+
+	static bool IsBlank(char c)		{ return (c == ' ') || (c == '\t') || (c == ','); }
+	static bool IsDigit(char c)		{ return (c >= '0') && (c <= '9'); }
+	static bool ParseInteger(const char *&cursor, const char *end, int64_t &value);
+	static bool ParseReal(const char *&cursor, const char *end, double &value);
+	static bool ConvertWeight(double value, T2 &weight);
+	static const char* SkipLine(const char *cursor, const char *end);
+
+	const char* ParseMatrixMarketHeader(const char *begin, const char *end, int64_t &num_vertices, int64_t &num_entries, bool &SYMMETRIC_COND, bool &PATTERN_COND);
+	template<typename Visitor>
+	const char* ParseEdgeLines(const char *begin, const char *end, bool PATTERN_COND, std::vector<TextEdge> &batch, Visitor &visitor) const;
+
+public:
+	GraphLoader(int32_t num_threads = 0);		// num_threads = 0 --> One thread per hardware core
+	~GraphLoader();
+
+	// flag = 0 --> Edge list (SNAP style): "u v [w]" per line, separated by blanks, tabs or commas, '#' and '%' comment lines,
+	//              a missing weight is 1;
+	//              uuids outside of the int64 range, non-finite weights, weights outside of the range of T2 and, for an integral T2,
+	//              fractional weights are malformed lines
+	// flag = 1 --> MatrixMarket coordinate file (real, integer or pattern; general or symmetric): entry (i, j) is the edge i --> j
+	//              and the uuid of a node is its 1-based row/column index
+	void Load(const std::string &file_name, int32_t flag = 0);
+
+	// The loaded Graph, for the caller to move out
+	std::vector<Node<T1> >& Nodes()		{ return nodes_; }
+	CSRGraph<T2>& Csr()		{ return csr_; }
+};
+
+
+template<typename T1, typename T2>
+GraphLoader<T1, T2>::GraphLoader(int32_t num_threads) : numThreads_(num_threads)
+{
+
+}
+
+
+template<typename T1, typename T2>
+GraphLoader<T1, T2>::~GraphLoader()
+{
+	nodes_.clear();
+}
+
+
+template<typename T1, typename T2>
+bool GraphLoader<T1, T2>::ParseInteger(const char *&cursor, const char *end, int64_t &value)
+{
+	bool NEGATIVE_COND = (cursor < end) && (*cursor == '-');
+	if ((cursor < end) && ((*cursor == '-') || (*cursor == '+')))		++cursor;
+	if ((cursor == end) || (!IsDigit(*cursor)))		return false;
+
+	// The magnitude is accumulated unsigned, so that INT64_MIN parses and an overflow is caught before it happens
+	uint64_t magnitude = 0, limit = uint64_t(INT64_MAX) + (NEGATIVE_COND ? 1 : 0);
+	while ((cursor < end) && (IsDigit(*cursor))) {
+		uint64_t digit = uint64_t(*cursor++ - '0');
+		if (magnitude > (limit - digit) / 10)		return false;
+		magnitude = magnitude * 10 + digit;
+	}
+	value = (NEGATIVE_COND) ? ((magnitude == 0) ? 0 : -int64_t(magnitude - 1) - 1) : int64_t(magnitude);
+	return true;
+}
+
+
+// Decimal number with an optional fraction and exponent. The digits are accumulated in an integer and scaled once, which is
+// exact for integers and within an ulp or two of strtod otherwise
+template<typename T1, typename T2>
+bool GraphLoader<T1, T2>::ParseReal(const char *&cursor, const char *end, double &value)
+{
+	bool NEGATIVE_COND = (cursor < end) && (*cursor == '-');
+	if ((cursor < end) && ((*cursor == '-') || (*cursor == '+')))		++cursor;
+
+	int64_t mantissa = 0;
+	int32_t exponent = 0;
+	bool DIGITS_COND = false;
+	for (; (cursor < end) && (IsDigit(*cursor)); ++cursor, DIGITS_COND = true) {
+		if (mantissa < 100000000000000000LL)		mantissa = mantissa * 10 + (*cursor - '0');
+		else ++exponent;
+	}
+	if ((cursor < end) && (*cursor == '.'))
+		for (++cursor; (cursor < end) && (IsDigit(*cursor)); ++cursor, DIGITS_COND = true)
+			if (mantissa < 100000000000000000LL) {
+				mantissa = mantissa * 10 + (*cursor - '0');
+				--exponent;
+			}
+	if (!DIGITS_COND)		return false;
+
+	if ((cursor < end) && ((*cursor == 'e') || (*cursor == 'E'))) {
+		int64_t exponent_value = 0;
+		++cursor;
+		if (!ParseInteger(cursor, end, exponent_value))		return false;
+		exponent += int32_t(std::max<int64_t>(-400, std::min<int64_t>(400, exponent_value)));
+	}
+
+	value = (exponent < 0) ? double(mantissa) / std::pow(10.0, -exponent) : double(mantissa) * std::pow(10.0, exponent);
+	if (NEGATIVE_COND)		value = -value;
+	return true;
+}
+
+
+// Converts a parsed weight to T2 without the undefined behavior of an out of range cast, false if T2 cannot hold it exactly
+// (integral T2) or at all (floating point T2)
+template<typename T1, typename T2>
+bool GraphLoader<T1, T2>::ConvertWeight(double value, T2 &weight)
+{
+	if (!std::isfinite(value))		return false;
+	if (std::numeric_limits<T2>::is_integer) {
+		// double(max) + 1 is a power of two, exact even where double(max) rounds up
+		if ((value < double(std::numeric_limits<T2>::min())) || (value >= double(std::numeric_limits<T2>::max()) + 1.0))		return false;
+		if (value != std::floor(value))		return false;
+	}
+	else if (std::fabs(value) > double(std::numeric_limits<T2>::max()))		return false;
+
+	weight = T2(value);
+	return true;
+}
+
+
+template<typename T1, typename T2>
+const char* GraphLoader<T1, T2>::SkipLine(const char *cursor, const char *end)
+{
+	while ((cursor < end) && (*cursor != '\n'))		++cursor;
+	return (cursor < end) ? cursor + 1 : end;
+}
+
+
+// Calls visitor(batch) for every EDGE_BATCH_SIZE edge lines of [begin, end) and for the rest, and returns nullptr, or the start
+// of the first malformed line
+template<typename T1, typename T2>
+template<typename Visitor>
+const char* GraphLoader<T1, T2>::ParseEdgeLines(const char *begin, const char *end, bool PATTERN_COND, std::vector<TextEdge> &batch, Visitor &visitor) const
+{
+	batch.clear();
+	const char *cursor = begin;
+	while (cursor < end) {
+		const char *line = cursor;
+		while ((cursor < end) && (IsBlank(*cursor)))		++cursor;
+		if ((cursor == end) || (*cursor == '\n') || (*cursor == '\r') || (*cursor == '#') || (*cursor == '%')) {
+			cursor = SkipLine(cursor, end);
+			continue;
+		}
+
+		int64_t u = 0, v = 0;
+		if (!ParseInteger(cursor, end, u))		return line;
+		while ((cursor < end) && (IsBlank(*cursor)))		++cursor;
+		if (!ParseInteger(cursor, end, v))		return line;
+		while ((cursor < end) && (IsBlank(*cursor)))		++cursor;
+
+		double weight = 1;
+		if ((!PATTERN_COND) && (cursor < end) && (*cursor != '\n') && (*cursor != '\r') && (!ParseReal(cursor, end, weight)))
+			return line;
+
+		TextEdge edge = { u, v, T2() };
+		if (!ConvertWeight(weight, edge.weight_))		return line;
+
+		cursor = SkipLine(cursor, end);
+		batch.push_back(edge);
+		if (batch.size() == EDGE_BATCH_SIZE) {
+			visitor(batch);
+			batch.clear();
+		}
+	}
+	if (!batch.empty())		visitor(batch);
+	return nullptr;
+}
+
+
+// Reads the banner "%%MatrixMarket matrix coordinate <field> <symmetry>", the comment lines and the size line
+// "rows columns entries", and returns the start of the entries
+template<typename T1, typename T2>
+const char* GraphLoader<T1, T2>::ParseMatrixMarketHeader(const char *begin, const char *end, int64_t &num_vertices, int64_t &num_entries, bool &SYMMETRIC_COND, bool &PATTERN_COND)
+{
+	const char *cursor = SkipLine(begin, end);
+	std::string banner(begin, cursor);
+	std::transform(banner.begin(), banner.end(), banner.begin(), ::tolower);
+
+	std::vector<std::string> token_list;
+	for (size_t i = 0; i < banner.size();) {
+		size_t token_end = banner.find_first_of(" \t\r\n", i);
+		if (token_end == std::string::npos)		token_end = banner.size();
+		if (token_end > i)		token_list.push_back(banner.substr(i, token_end - i));
+		i = token_end + 1;
+	}
+	if ((token_list.size() != 5) || (token_list[0] != "%%matrixmarket") || (token_list[1] != "matrix"))
+		throw std::runtime_error("ERROR: Missing %%MatrixMarket matrix banner");
+	if (token_list[2] != "coordinate")
+		throw std::runtime_error("ERROR: Only MatrixMarket coordinate files describe a Graph");
+	if ((token_list[3] != "real") && (token_list[3] != "double") && (token_list[3] != "integer") && (token_list[3] != "pattern"))
+		throw std::runtime_error("ERROR: Unsupported MatrixMarket field " + token_list[3]);
+	if ((token_list[4] != "general") && (token_list[4] != "symmetric"))
+		throw std::runtime_error("ERROR: Unsupported MatrixMarket symmetry " + token_list[4]);
+	PATTERN_COND = (token_list[3] == "pattern");
+	SYMMETRIC_COND = (token_list[4] == "symmetric");
+
+	while ((cursor < end) && ((*cursor == '%') || (*cursor == '\n') || (*cursor == '\r')))		cursor = SkipLine(cursor, end);
+
+	int64_t num_rows = 0, num_columns = 0;
+	while ((cursor < end) && (IsBlank(*cursor)))		++cursor;
+	bool SIZE_COND = ParseInteger(cursor, end, num_rows);
+	while ((cursor < end) && (IsBlank(*cursor)))		++cursor;
+	SIZE_COND = SIZE_COND && ParseInteger(cursor, end, num_columns);
+	while ((cursor < end) && (IsBlank(*cursor)))		++cursor;
+	SIZE_COND = SIZE_COND && ParseInteger(cursor, end, num_entries);
+	if ((!SIZE_COND) || (num_rows < 0) || (num_columns < 0) || (num_entries < 0))
+		throw std::runtime_error("ERROR: Missing MatrixMarket size line");
+
+	num_vertices = std::max(num_rows, num_columns);
+	return SkipLine(cursor, end);
+}
+
+
+template<typename T1, typename T2>
+void GraphLoader<T1, T2>::Load(const std::string &file_name, int32_t flag /* = 0 */)
+{
+	if ((flag != 0) && (flag != 1))
+		throw std::invalid_argument("ERROR: Invalid Graph file format flag " + std::to_string(flag));
+
+	MappedFile file(file_name);
+	const char *begin = file.Data(), *end = file.Data() + file.Size();
+
+	bool MATRIX_MARKET_COND = (flag == 1), SYMMETRIC_COND = false, PATTERN_COND = false;
+	int64_t num_vertices = 0, num_entries = -1;
+	if (MATRIX_MARKET_COND)		begin = ParseMatrixMarketHeader(begin, end, num_vertices, num_entries, SYMMETRIC_COND, PATTERN_COND);
+
+	// Chunk c is [chunk_list[c], chunk_list[c + 1]), every boundary moved forward to the start of a line
+	ThreadPool thread_pool(numThreads_);
+	int64_t num_chunks = std::max<int64_t>(int64_t(thread_pool.NumThreads()) * 4, (end - begin) / CHUNK_SIZE + 1);
+	std::vector<const char *> chunk_list(num_chunks + 1, end);
+	chunk_list[0] = begin;
+	for (int64_t c = 1; c < num_chunks; c++) {
+		const char *cursor = std::max(begin + (end - begin) / num_chunks * c, chunk_list[c - 1]);
+		while ((cursor < end) && (cursor > begin) && (cursor[-1] != '\n'))		++cursor;
+		chunk_list[c] = cursor;
+	}
+
+	std::vector<const char *> error_list(num_chunks, nullptr);
+	auto check_errors = [&]() {
+		for (const auto &elem : error_list)
+			if (elem != nullptr)
+				throw std::runtime_error("ERROR: Malformed edge line at byte " + std::to_string(elem - file.Data()) + " of " + file_name);
+	};
+
+	// Stage 1, edge lists: sorted unique uuids of every thread, merged into the dense id --> uuid table
+	std::vector<int64_t> uuid_list;
+	if (!MATRIX_MARKET_COND) {
+		std::vector<std::vector<int64_t> > local_uuid_lists(thread_pool.NumThreads());
+		thread_pool.ParallelFor(0, num_chunks, [&](int64_t begin_index, int64_t end_index, int32_t thread_id) {
+			std::vector<int64_t> chunk_uuid_list, merged_uuid_list;
+			std::vector<TextEdge> batch;
+			for (int64_t c = begin_index; c < end_index; c++) {
+				chunk_uuid_list.clear();
+				auto collect_uuids = [&](const std::vector<TextEdge> &edge_batch) {
+					for (const auto &elem : edge_batch) {
+						chunk_uuid_list.push_back(elem.u_);
+						chunk_uuid_list.push_back(elem.v_);
+					}
+				};
+				error_list[c] = ParseEdgeLines(chunk_list[c], chunk_list[c + 1], false, batch, collect_uuids);
+
+				std::sort(chunk_uuid_list.begin(), chunk_uuid_list.end());
+				chunk_uuid_list.erase(std::unique(chunk_uuid_list.begin(), chunk_uuid_list.end()), chunk_uuid_list.end());
+				std::vector<int64_t> &local_uuid_list = local_uuid_lists[thread_id];
+				merged_uuid_list.clear();
+				std::set_union(local_uuid_list.begin(), local_uuid_list.end(), chunk_uuid_list.begin(), chunk_uuid_list.end(), std::back_inserter(merged_uuid_list));
+				local_uuid_list.swap(merged_uuid_list);
+			}
+		}, 1);
+		check_errors();
+
+		for (auto &elem : local_uuid_lists) {
+			std::vector<int64_t> merged_uuid_list;
+			std::set_union(uuid_list.begin(), uuid_list.end(), elem.begin(), elem.end(), std::back_inserter(merged_uuid_list));
+			uuid_list.swap(merged_uuid_list);
+			std::vector<int64_t>().swap(elem);
+		}
+		num_vertices = uuid_list.size();
+	}
+	if (num_vertices > INT32_MAX)		throw std::runtime_error("ERROR: " + file_name + " has more than 2^31 - 1 nodes");
+
+	// Open addressing table uuid --> dense id, at most half full: a lookup costs about one cache miss, where a binary search
+	// of uuid_list costs log2(V) of them, and stages 2 and 3 look up both ends of every edge
+	std::vector<std::pair<int64_t, int32_t> > uuid_table;
+	uint64_t table_mask = 0;
+	int32_t table_shift = 63;		// Fibonacci hashing: the slot is the top bits of uuid * 2^64 / golden ratio
+	if (!MATRIX_MARKET_COND) {
+		while ((uint64_t(1) << (64 - table_shift)) < 2 * uint64_t(num_vertices))		--table_shift;
+		table_mask = (uint64_t(1) << (64 - table_shift)) - 1;
+		uuid_table.assign(table_mask + 1, std::pair<int64_t, int32_t>(0, -1));
+		for (int64_t i = 0; i < num_vertices; i++) {
+			uint64_t slot = uint64_t(uuid_list[i]) * 0x9E3779B97F4A7C15ULL >> table_shift;
+			while (uuid_table[slot].second >= 0)		slot = (slot + 1) & table_mask;
+			uuid_table[slot] = std::pair<int64_t, int32_t>(uuid_list[i], int32_t(i));
+		}
+	}
+
+	// Dense id of a uuid, -1 for a MatrixMarket index out of range
+	auto dense_id = [&](int64_t uuid) -> int32_t {
+		if (MATRIX_MARKET_COND)		return ((uuid >= 1) && (uuid <= num_vertices)) ? int32_t(uuid - 1) : -1;
+		uint64_t slot = uint64_t(uuid) * 0x9E3779B97F4A7C15ULL >> table_shift;
+		while (uuid_table[slot].first != uuid)		slot = (slot + 1) & table_mask;
+		return uuid_table[slot].second;
+	};
+	auto dense_id_batch = [&](const std::vector<TextEdge> &edge_batch, std::vector<std::pair<int32_t, int32_t> > &id_list) {
+		id_list.resize(edge_batch.size());
+		for (size_t k = 0; k < edge_batch.size(); k++)
+			id_list[k] = std::pair<int32_t, int32_t>(dense_id(edge_batch[k].u_), dense_id(edge_batch[k].v_));
+	};
+
+	// Stage 2: out-degrees, turned into the offsets and then reused as the insert positions of stage 3
+	std::vector<std::atomic<int64_t> > position_list(num_vertices);
+	for (auto &elem : position_list)		elem.store(0, std::memory_order_relaxed);
+	std::atomic<int64_t> num_parsed_entries(0), num_invalid_entries(0);
+	thread_pool.ParallelFor(0, num_chunks, [&](int64_t begin_index, int64_t end_index, int32_t /*thread_id*/) {
+		int64_t local_num_entries = 0, local_num_invalid_entries = 0;
+		std::vector<TextEdge> batch;
+		std::vector<std::pair<int32_t, int32_t> > id_list;
+		auto count_edges = [&](const std::vector<TextEdge> &edge_batch) {
+			dense_id_batch(edge_batch, id_list);
+			local_num_entries += edge_batch.size();
+			for (const auto &elem : id_list) {
+				if ((elem.first < 0) || (elem.second < 0)) {
+					++local_num_invalid_entries;
+					continue;
+				}
+				position_list[elem.first].fetch_add(1, std::memory_order_relaxed);
+				if ((SYMMETRIC_COND) && (elem.first != elem.second))		position_list[elem.second].fetch_add(1, std::memory_order_relaxed);
+			}
+		};
+		for (int64_t c = begin_index; c < end_index; c++)
+			error_list[c] = ParseEdgeLines(chunk_list[c], chunk_list[c + 1], PATTERN_COND, batch, count_edges);
+		num_parsed_entries.fetch_add(local_num_entries);
+		num_invalid_entries.fetch_add(local_num_invalid_entries);
+	}, 1);
+	check_errors();
+	if (num_invalid_entries.load() > 0)
+		throw std::runtime_error("ERROR: " + file_name + " holds " + std::to_string(num_invalid_entries.load()) + " entries outside of the matrix");
+	if ((MATRIX_MARKET_COND) && (num_parsed_entries.load() != num_entries))
+		throw std::runtime_error("ERROR: " + file_name + " holds " + std::to_string(num_parsed_entries.load()) + " entries instead of " + std::to_string(num_entries));
+
+	std::vector<int64_t> offsets(num_vertices + 1, 0);
+	for (int64_t i = 0; i < num_vertices; i++) {
+		offsets[i + 1] = offsets[i] + position_list[i].load(std::memory_order_relaxed);
+		position_list[i].store(offsets[i], std::memory_order_relaxed);
+	}
+	if (offsets[num_vertices] > INT32_MAX)		throw std::runtime_error("ERROR: " + file_name + " has more than 2^31 - 1 edges");
+
+	// Stage 3: every edge claims a slot of its source vertex, then every adjacency is sorted so the result does not depend on
+	// the thread schedule
+	std::vector<int32_t> neighbors(offsets[num_vertices]);
+	std::vector<T2> weights(offsets[num_vertices]);
+	thread_pool.ParallelFor(0, num_chunks, [&](int64_t begin_index, int64_t end_index, int32_t /*thread_id*/) {
+		std::vector<TextEdge> batch;
+		std::vector<std::pair<int32_t, int32_t> > id_list;
+		auto scatter_edges = [&](const std::vector<TextEdge> &edge_batch) {
+			dense_id_batch(edge_batch, id_list);
+			for (size_t k = 0; k < edge_batch.size(); k++) {
+				int32_t i = id_list[k].first, j = id_list[k].second;
+				int64_t position = position_list[i].fetch_add(1, std::memory_order_relaxed);
+				neighbors[position] = j;
+				weights[position] = edge_batch[k].weight_;
+				if ((SYMMETRIC_COND) && (i != j)) {
+					position = position_list[j].fetch_add(1, std::memory_order_relaxed);
+					neighbors[position] = i;
+					weights[position] = edge_batch[k].weight_;
+				}
+			}
+		};
+		for (int64_t c = begin_index; c < end_index; c++)
+			ParseEdgeLines(chunk_list[c], chunk_list[c + 1], PATTERN_COND, batch, scatter_edges);
+	}, 1);
+	std::vector<std::atomic<int64_t> >().swap(position_list);
+	std::vector<std::pair<int64_t, int32_t> >().swap(uuid_table);
+
+	thread_pool.ParallelFor(0, num_vertices, [&](int64_t begin_index, int64_t end_index, int32_t /*thread_id*/) {
+		std::vector<std::pair<int32_t, T2> > edge_list;
+		for (int64_t i = begin_index; i < end_index; i++) {
+			if (offsets[i + 1] - offsets[i] < 2)		continue;
+			edge_list.clear();
+			for (int64_t e = offsets[i]; e < offsets[i + 1]; e++)		edge_list.push_back(std::pair<int32_t, T2>(neighbors[e], weights[e]));
+			std::sort(edge_list.begin(), edge_list.end());
+			for (int64_t e = offsets[i]; e < offsets[i + 1]; e++) {
+				neighbors[e] = edge_list[e - offsets[i]].first;
+				weights[e] = edge_list[e - offsets[i]].second;
+			}
+		}
+	}, 4096);
+
+	nodes_.clear();
+	nodes_.reserve(num_vertices);
+	for (int64_t i = 0; i < num_vertices; i++)
+		nodes_.push_back(Node<T1>(T1(), MATRIX_MARKET_COND ? i + 1 : uuid_list[i]));
+	csr_ = CSRGraph<T2>(std::move(offsets), std::move(neighbors), std::move(weights));
+}
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHLOADER_H
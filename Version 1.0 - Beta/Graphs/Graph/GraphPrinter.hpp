@@ -0,0 +1,164 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// GraphPrinter.hpp: Contains the declaration and definition of different methods of the GraphPrinter class
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHPRINTER_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHPRINTER_H
+
+#include "GraphResults.hpp"
+
+#include <vector>
+#include <string>
+
+#include <stdint.h>
+
+template<typename T1, typename T2>
+class Graph;
+
+// Optional text formatting of the typed Graph results, nodes are written by uuid.
+// Only the string based Graph methods and the callers that want text pay for the std::to_string work
+template<typename T1, typename T2>
+class GraphPrinter {
+public:
+	// "uuid-uuid" for every tree edge, in visiting order
+	static void WriteTraversalEdges(const Graph<T1, T2> &graph, const TraversalResult &result, std::vector<std::string> &traversal_edge_list);
+	// "\nNumber of Iterations = k\n", then "uuid  -->  distance     predecessor_uuid\n" for every vertex
+	static void WriteShortestPath(const Graph<T1, T2> &graph, const ShortestPathResult<T2> &result, std::vector<std::string> &shortest_path);
+	// "(uuid->distance,predecessor_uuid);..." for every vertex on one line
+	static std::string LabelsString(const Graph<T1, T2> &graph, const std::vector<T2> &distance_list, const std::vector<int32_t> &predecessor_list, int32_t source_vertex);
+	// uuid of every vertex on the path from the source to the target, nothing if the target is unreachable
+	static void WritePath(const Graph<T1, T2> &graph, const PointToPointResult<T2> &result, std::vector<std::string> &path_vertices_list);
+	// Tab separated distance matrix with a uuid header row and column
+	static void WriteAllPairsShortestPath(const Graph<T1, T2> &graph, const AllPairsShortestPathResult<T2> &result, std::vector<std::string> &shortest_path);
+	// Tab separated Adjacency Matrix of the tree: +weight for start-->end, -weight for end<--start
+	static void WriteSpanningTree(const Graph<T1, T2> &graph, const SpanningTreeResult<T2> &result, std::vector<std::string> &mst_adjacency_matrix);
+	// uuid of every vertex in topological order, nothing if the Graph has a cycle
+	static void WriteTopologicalOrder(const Graph<T1, T2> &graph, const TopologicalSortResult &result, std::vector<std::string> &topological_sort_vertices_list);
+};
+
+
+template<typename T1, typename T2>
+void GraphPrinter<T1, T2>::WriteTraversalEdges(const Graph<T1, T2> &graph, const TraversalResult &result, std::vector<std::string> &traversal_edge_list)
+{
+	for (const auto &v : result.order_)
+		if (result.parents_[v] != v)
+			traversal_edge_list.push_back(std::to_string(graph.GetNode(result.parents_[v]).uuid_) + "-" + std::to_string(graph.GetNode(v).uuid_));
+}
+
+
+// The legacy format names the source as the predecessor of the source and of the unreachable vertices.
+// A negative cycle replaces the distance list, whose labels are not shortest paths then
+template<typename T1, typename T2>
+void GraphPrinter<T1, T2>::WriteShortestPath(const Graph<T1, T2> &graph, const ShortestPathResult<T2> &result, std::vector<std::string> &shortest_path)
+{
+	shortest_path.push_back("\nNumber of Iterations = " + std::to_string(result.numIterations_) + "\n");
+	if (!result.negativeCycle_.empty()) {
+		std::string cycle_str = "Negative Cycle Detected: { ";
+		for (size_t i = 0; i < result.negativeCycle_.size(); i++)
+			cycle_str += std::to_string(graph.GetNode(result.negativeCycle_[i]).uuid_) + ((i + 1 == result.negativeCycle_.size()) ? " }\n" : ", ");
+		shortest_path.push_back(cycle_str);
+		return;
+	}
+
+	for (int32_t i = 0; i < graph.NumNodes(); i++) {
+		int32_t predecessor = (result.predecessors_[i] == -1) ? result.sourceVertex_ : result.predecessors_[i];
+		std::string elem_details = std::to_string(graph.GetNode(i).uuid_) + "  -->  " +
+			                       std::to_string(result.distances_[i]) + "     " +
+								   std::to_string(graph.GetNode(predecessor).uuid_) + "\n";
+		shortest_path.push_back(elem_details);
+	}
+}
+
+
+template<typename T1, typename T2>
+void GraphPrinter<T1, T2>::WritePath(const Graph<T1, T2> &graph, const PointToPointResult<T2> &result, std::vector<std::string> &path_vertices_list)
+{
+	for (const auto &elem : result.path_)
+		path_vertices_list.push_back(std::to_string(graph.GetNode(elem).uuid_));
+}
+
+
+template<typename T1, typename T2>
+std::string GraphPrinter<T1, T2>::LabelsString(const Graph<T1, T2> &graph, const std::vector<T2> &distance_list, const std::vector<int32_t> &predecessor_list, int32_t source_vertex)
+{
+	std::string path_iter_str = "";
+	for (int32_t i = 0; i < graph.NumNodes(); i++)	{
+		int32_t predecessor = (predecessor_list[i] == -1) ? source_vertex : predecessor_list[i];
+		path_iter_str += "(" + std::to_string(graph.GetNode(i).uuid_) +
+						 "->" + std::to_string(distance_list[i]) +
+						 "," + std::to_string(graph.GetNode(predecessor).uuid_) + ")";
+		path_iter_str += (i == graph.NumNodes() - 1) ? "" : ";";
+	}
+
+	return path_iter_str;
+}
+
+
+template<typename T1, typename T2>
+void GraphPrinter<T1, T2>::WriteAllPairsShortestPath(const Graph<T1, T2> &graph, const AllPairsShortestPathResult<T2> &result, std::vector<std::string> &shortest_path)
+{
+	std::string nodes_info_str = "\t";
+	for (int32_t i = 0; i < graph.NumNodes(); i++)	nodes_info_str += std::to_string(graph.GetNode(i).uuid_) + "\t";
+	shortest_path.push_back(nodes_info_str + "\n");
+
+	for (int32_t i = 0; i < graph.NumNodes(); i++) {
+		nodes_info_str = std::to_string(graph.GetNode(i).uuid_) + "\t";
+		for (int32_t j = 0; j < graph.NumNodes(); j++)
+			nodes_info_str += std::to_string(result.Distance(i, j)) + "\t";
+		nodes_info_str += "\n";
+		shortest_path.push_back(nodes_info_str);
+	}
+}
+
+
+template<typename T1, typename T2>
+void GraphPrinter<T1, T2>::WriteSpanningTree(const Graph<T1, T2> &graph, const SpanningTreeResult<T2> &result, std::vector<std::string> &mst_adjacency_matrix)
+{
+	int32_t num_nodes = graph.NumNodes();
+	std::vector<std::vector<T2> > adjacency_matrix(num_nodes, std::vector<T2>(num_nodes, T2(0)));
+	for (const auto &elem : result.edges_) {
+		adjacency_matrix[elem.second.first][elem.second.second] = elem.first;
+		adjacency_matrix[elem.second.second][elem.second.first] = T2(-1) * elem.first;
+	}
+
+	std::string nodes_info_str = "\t";
+	for (int32_t i = 0; i < num_nodes; i++)	nodes_info_str += std::to_string(graph.GetNode(i).uuid_) + "\t";
+	mst_adjacency_matrix.push_back(nodes_info_str + "\n");
+
+	for (int32_t i = 0; i < num_nodes; i++) {
+		nodes_info_str = std::to_string(graph.GetNode(i).uuid_) + "\t";
+		for (const auto & elem2 : adjacency_matrix[i])		nodes_info_str += std::to_string(elem2) + "\t";
+		nodes_info_str += "\n";
+		mst_adjacency_matrix.push_back(nodes_info_str);
+	}
+}
+
+
+template<typename T1, typename T2>
+void GraphPrinter<T1, T2>::WriteTopologicalOrder(const Graph<T1, T2> &graph, const TopologicalSortResult &result, std::vector<std::string> &topological_sort_vertices_list)
+{
+	if (!result.acyclic_)		return;
+
+	for (const auto &elem : result.order_)		topological_sort_vertices_list.push_back(std::to_string(graph.GetNode(elem).uuid_));
+}
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHPRINTER_H
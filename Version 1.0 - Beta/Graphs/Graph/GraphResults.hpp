@@ -0,0 +1,112 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// GraphResults.hpp: Contains the typed result structures returned by the Graph algorithms
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHRESULTS_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHRESULTS_H
+
+#include <vector>
+
+#include <stdint.h>
+
+// All the results are indexed by the dense node index [0, NumNodes()) of the Graph; Graph::GetNode(index) gives the node.
+// GraphPrinter turns any of them into the text format of the string based Graph methods
+
+
+// Breadth/Depth First Search forest
+struct TraversalResult {
+	int32_t sourceVertex_;		// -1 for a DFS over all the vertices
+	std::vector<int32_t> parents_;		// Tree parent, the vertex itself for a root, -1 if never reached
+	std::vector<int32_t> levels_;		// Depth in the tree, -1 if never reached
+	std::vector<int32_t> order_;		// Reached vertices in visiting order
+
+	TraversalResult() : sourceVertex_(-1) { }
+};
+
+
+// Single Source Shortest Paths
+template<typename T2>
+struct ShortestPathResult {
+	int32_t sourceVertex_;
+	std::vector<T2> distances_;		// Graph::InfiniteWeight() if unreachable
+	std::vector<int32_t> predecessors_;		// Previous vertex on the shortest path, -1 for the source and the unreachable vertices
+	std::vector<int32_t> negativeCycle_;		// Vertices of a negative cycle reachable from the source in edge order, empty if there is none
+	int64_t numIterations_;
+
+	ShortestPathResult() : sourceVertex_(-1), numIterations_(0) { }
+};
+
+
+// Point-To-Point Shortest Path
+template<typename T2>
+struct PointToPointResult {
+	int32_t sourceVertex_;
+	int32_t targetVertex_;
+	T2 distance_;		// Graph::InfiniteWeight() if the target is unreachable
+	std::vector<int32_t> path_;		// Source, ..., Target; empty if the target is unreachable
+	int64_t numSettledVertices_;		// Vertices settled by both searches, a measure of the work of the query
+
+	PointToPointResult() : sourceVertex_(-1), targetVertex_(-1), distance_(T2(0)), numSettledVertices_(0) { }
+};
+
+
+// All-To-All Shortest Paths
+template<typename T2>
+struct AllPairsShortestPathResult {
+	int32_t numVertices_;
+	std::vector<T2> distances_;		// Row-major numVertices_ x numVertices_, Graph::InfiniteWeight() if unreachable
+
+	AllPairsShortestPathResult() : numVertices_(0) { }
+	const T2& Distance(int32_t start_vertex, int32_t end_vertex) const		{ return distances_[int64_t(start_vertex) * numVertices_ + end_vertex]; }
+};
+
+
+// Minimum Spanning Tree (or Forest)
+template<typename T2>
+struct SpanningTreeResult {
+	std::vector<std::pair<T2, std::pair<int32_t, int32_t> > > edges_;		// (Weight, (Start vertex, End vertex)) in the stored edge direction
+	T2 totalWeight_;
+
+	SpanningTreeResult() : totalWeight_(T2(0)) { }
+};
+
+
+// Topological Sort: wavefront k, the vertices whose dependencies are all in the wavefronts 0..k-1, is order_[levelOffsets_[k], levelOffsets_[k+1])
+struct TopologicalSortResult {
+	bool acyclic_;		// false if the Graph has a cycle, order_ then only holds the vertices that precede it
+	std::vector<int32_t> order_;
+	std::vector<int32_t> levelOffsets_;
+
+	TopologicalSortResult() : acyclic_(true), levelOffsets_(1, 0) { }
+	int32_t NumLevels() const		{ return int32_t(levelOffsets_.size()) - 1; }
+};
+
+
+// Connected Components
+struct ComponentResult {
+	int32_t numComponents_;
+	std::vector<int32_t> components_;		// Component id in [0, numComponents_) of every vertex
+
+	ComponentResult() : numComponents_(0) { }
+};
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_GRAPHRESULTS_H
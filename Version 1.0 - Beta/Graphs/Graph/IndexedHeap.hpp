@@ -0,0 +1,193 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// IndexedHeap.hpp: Contains the declaration and definition of different data members and methods of the IndexedHeap class
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_INDEXEDHEAP_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_INDEXEDHEAP_H
+
+#include <vector>
+#include <stdexcept>
+
+#include <stdint.h>
+
+// Addressable 4-ary min heap over the dense vertex indices [0, numVertices_)
+// positions_ maps every vertex to its slot in heap_ (-1 if the vertex is not in the heap), so DecreaseKey
+// costs O(log V) without searching. A 4-ary heap is shallower than a binary heap and its 4 children share a cache line
+template<typename T2>
+class IndexedHeap {
+private:
+	static const int32_t ARITY = 4;
+
+	std::vector<int32_t> heap_;		// Heap slot --> Vertex
+	std::vector<int32_t> positions_;	// Vertex --> Heap slot
+	std::vector<T2> keys_;			// Vertex --> Key
+
+	void MoveUp(int32_t slot);
+	void MoveDown(int32_t slot);
+
+public:
+	IndexedHeap(int32_t num_vertices = 0);
+	~IndexedHeap();
+
+	void Resize(int32_t num_vertices);
+	void Clear();		// O(size of the heap), so the heap can be reused across runs without an O(V) reset
+
+	bool Empty() const		{ return heap_.empty(); }
+	int32_t Size() const		{ return int32_t(heap_.size()); }
+	bool Contains(int32_t vertex) const		{ return positions_[vertex] >= 0; }
+	const T2& Key(int32_t vertex) const		{ return keys_[vertex]; }
+	int32_t Top() const		{ return heap_[0]; }
+	const T2& TopKey() const		{ return keys_[heap_[0]]; }
+
+	void Push(int32_t vertex, const T2& key);
+	void DecreaseKey(int32_t vertex, const T2& key);
+	void PushOrDecreaseKey(int32_t vertex, const T2& key);
+	int32_t Pop();
+};
+
+
+template<typename T2>
+IndexedHeap<T2>::IndexedHeap(int32_t num_vertices)
+{
+	Resize(num_vertices);
+}
+
+
+template<typename T2>
+IndexedHeap<T2>::~IndexedHeap()
+{
+	heap_.clear();
+	positions_.clear();
+	keys_.clear();
+}
+
+
+template<typename T2>
+void IndexedHeap<T2>::Resize(int32_t num_vertices)
+{
+	heap_.clear();
+	heap_.reserve(num_vertices);
+	positions_ = std::vector<int32_t>(num_vertices, -1);
+	keys_ = std::vector<T2>(num_vertices);
+}
+
+
+template<typename T2>
+void IndexedHeap<T2>::Clear()
+{
+	for (const auto &elem : heap_)		positions_[elem] = -1;
+	heap_.clear();
+}
+
+
+template<typename T2>
+void IndexedHeap<T2>::MoveUp(int32_t slot)
+{
+	int32_t vertex = heap_[slot];
+	while (slot > 0) {
+		int32_t parent_slot = (slot - 1) / ARITY;
+		if (!(keys_[vertex] < keys_[heap_[parent_slot]]))		break;
+
+		heap_[slot] = heap_[parent_slot];
+		positions_[heap_[slot]] = slot;
+		slot = parent_slot;
+	}
+
+	heap_[slot] = vertex;
+	positions_[vertex] = slot;
+}
+
+
+template<typename T2>
+void IndexedHeap<T2>::MoveDown(int32_t slot)
+{
+	int32_t vertex = heap_[slot];
+	int32_t heap_size = int32_t(heap_.size());
+	while (true) {
+		int32_t first_child_slot = ARITY * slot + 1;
+		if (first_child_slot >= heap_size)		break;
+
+		int32_t min_child_slot = first_child_slot;
+		int32_t last_child_slot = (first_child_slot + ARITY < heap_size) ? first_child_slot + ARITY : heap_size;
+		for (int32_t i = first_child_slot + 1; i < last_child_slot; i++)
+			if (keys_[heap_[i]] < keys_[heap_[min_child_slot]])		min_child_slot = i;
+
+		if (!(keys_[heap_[min_child_slot]] < keys_[vertex]))		break;
+
+		heap_[slot] = heap_[min_child_slot];
+		positions_[heap_[slot]] = slot;
+		slot = min_child_slot;
+	}
+
+	heap_[slot] = vertex;
+	positions_[vertex] = slot;
+}
+
+
+template<typename T2>
+void IndexedHeap<T2>::Push(int32_t vertex, const T2& key)
+{
+	if (Contains(vertex))
+		throw std::logic_error("ERROR: Vertex is already present in the Indexed Heap");
+
+	keys_[vertex] = key;
+	heap_.push_back(vertex);
+	MoveUp(int32_t(heap_.size()) - 1);
+}
+
+
+template<typename T2>
+void IndexedHeap<T2>::DecreaseKey(int32_t vertex, const T2& key)
+{
+	keys_[vertex] = key;
+	MoveUp(positions_[vertex]);
+}
+
+
+template<typename T2>
+void IndexedHeap<T2>::PushOrDecreaseKey(int32_t vertex, const T2& key)
+{
+	if (Contains(vertex))		DecreaseKey(vertex, key);
+	else Push(vertex, key);
+}
+
+
+template<typename T2>
+int32_t IndexedHeap<T2>::Pop()
+{
+	if (heap_.empty())
+		throw std::runtime_error("ERROR: The Indexed Heap is empty");
+
+	int32_t top_vertex = heap_[0];
+	positions_[top_vertex] = -1;
+
+	int32_t last_vertex = heap_.back();
+	heap_.pop_back();
+	if (!heap_.empty()) {
+		heap_[0] = last_vertex;
+		MoveDown(0);
+	}
+
+	return top_vertex;
+}
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_INDEXEDHEAP_H
@@ -0,0 +1,162 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// MappedArray.hpp: Contains the read-only file mapping and the MappedArray storage shared by the CSR arrays and the Graph tables
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_MAPPEDARRAY_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_MAPPEDARRAY_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+// Whole file mapped read-only and shared: the pages come straight from the page cache, so every process that maps the same
+// file shares one copy of it, and nothing is read until it is touched. An empty file cannot be mapped and is an empty view
+class MappedFile {
+private:
+	const char *data_;
+	size_t size_;
+
+	MappedFile(const MappedFile &);		// Not copyable, shared through std::shared_ptr
+	MappedFile& operator=(const MappedFile &);
+
+public:
+	explicit MappedFile(const std::string &file_name);
+	~MappedFile();
+
+	const char* Data() const		{ return data_; }
+	size_t Size() const		{ return size_; }
+};
+
+
+inline MappedFile::MappedFile(const std::string &file_name) : data_(nullptr), size_(0)
+{
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)		throw std::runtime_error("ERROR: Cannot open " + file_name + " for reading");
+
+	LARGE_INTEGER file_size;
+	HANDLE mapping = NULL;
+	bool SIZE_COND = (GetFileSizeEx(file, &file_size) != 0);
+	if ((SIZE_COND) && (file_size.QuadPart == 0)) {
+		CloseHandle(file);
+		data_ = "";
+		return;
+	}
+	if (SIZE_COND)		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping != NULL) {
+		data_ = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		CloseHandle(mapping);		// The view keeps the mapping alive
+	}
+	CloseHandle(file);
+	if (data_ == nullptr)		throw std::runtime_error("ERROR: Cannot map " + file_name);
+	size_ = size_t(file_size.QuadPart);
+#else
+	int file = open(file_name.c_str(), O_RDONLY);
+	if (file < 0)		throw std::runtime_error("ERROR: Cannot open " + file_name + " for reading");
+
+	struct stat file_status;
+	void *data = MAP_FAILED;
+	bool SIZE_COND = (fstat(file, &file_status) == 0);
+	if ((SIZE_COND) && (file_status.st_size == 0)) {
+		close(file);
+		data_ = "";
+		return;
+	}
+	if (SIZE_COND)		data = mmap(nullptr, size_t(file_status.st_size), PROT_READ, MAP_SHARED, file, 0);
+	close(file);		// The mapping stays valid after the descriptor is closed
+	if (data == MAP_FAILED)		throw std::runtime_error("ERROR: Cannot map " + file_name);
+	data_ = static_cast<const char *>(data);
+	size_ = size_t(file_status.st_size);
+#endif
+}
+
+
+inline MappedFile::~MappedFile()
+{
+	if (size_ == 0)		return;
+#if defined(_WIN32)
+	UnmapViewOfFile(data_);
+#else
+	munmap(const_cast<char *>(data_), size_);
+#endif
+}
+
+
+// Read-only array that either owns its elements in a std::vector or views them inside a MappedFile, which it keeps alive.
+// The classes built on it (CSRGraph, Graph) read both kinds the same way, so a Graph loaded from a file uses the mapped
+// pages directly and a copy of it shares them instead of copying the elements
+template<typename T>
+class MappedArray {
+private:
+	std::vector<T> values_;		// Owned elements, empty for a mapped array
+	std::shared_ptr<const MappedFile> file_;		// Null for an owned array
+	const T *data_;
+	size_t size_;
+
+public:
+	MappedArray() : data_(nullptr), size_(0) { }
+	MappedArray(std::vector<T> values) : values_(std::move(values)), data_(values_.data()), size_(values_.size()) { }
+	MappedArray(const std::shared_ptr<const MappedFile> &file, const T *data, size_t size) : file_(file), data_(data), size_(size) { }
+	MappedArray(const MappedArray &other) : values_(other.values_), file_(other.file_), data_(other.file_ ? other.data_ : values_.data()), size_(other.size_) { }
+	MappedArray(MappedArray &&other) : values_(std::move(other.values_)), file_(std::move(other.file_)), data_(other.data_), size_(other.size_) {		// Moving a vector keeps its buffer
+		other.data_ = nullptr;
+		other.size_ = 0;
+	}
+
+	MappedArray& operator=(MappedArray other) {
+		values_.swap(other.values_);
+		file_.swap(other.file_);
+		std::swap(data_, other.data_);
+		std::swap(size_, other.size_);
+		return *this;
+	}
+
+	bool IsMapped() const		{ return bool(file_); }
+	size_t size() const		{ return size_; }
+	bool empty() const		{ return size_ == 0; }
+	const T* data() const		{ return data_; }
+	const T* begin() const		{ return data_; }
+	const T* end() const		{ return data_ + size_; }
+	const T& back() const		{ return data_[size_ - 1]; }
+	const T& operator[](size_t index) const		{ return data_[index]; }
+
+	void clear()		{ *this = MappedArray(); }
+};
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_MAPPEDARRAY_H
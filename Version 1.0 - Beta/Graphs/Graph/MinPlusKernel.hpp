@@ -0,0 +1,113 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// MinPlusKernel.hpp: Contains the min-plus row update used by the blocked Floyd-Warshall (WFI) algorithm
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_MINPLUSKERNEL_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_MINPLUSKERNEL_H
+
+#include <stdint.h>
+
+// MSVC defines __AVX2__ under /arch:AVX2, which the Release configuration of Graph.vcxproj sets, and __AVX__ under /arch:AVX
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_MINPLUS_AVX2
+#elif defined(__SSE4_1__) || defined(__AVX__)
+#include <smmintrin.h>
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_MINPLUS_SSE41
+#endif
+
+
+// row_i[j] = min(row_i[j], distance_ik + row_k[j]) for j in [0, length), skipping the j with row_k[j] >= infinite: with a negative
+// distance_ik, infinite + distance_ik would otherwise fall below infinite and pass for a path.
+// row_i and row_k must not overlap. The generic version is a branch free loop the compiler can vectorize,
+// the int32_t and float overloads use SSE4.1/AVX2 explicitly (compare and blend) when the target supports them
+template<typename T2>
+inline void MinPlusRowUpdate(T2 *row_i, const T2 *row_k, T2 distance_ik, T2 infinite, int32_t length)
+{
+	for (int32_t j = 0; j < length; j++) {
+		T2 path_distance = distance_ik + row_k[j];
+		row_i[j] = ((row_k[j] < infinite) && (path_distance < row_i[j])) ? path_distance : row_i[j];
+	}
+}
+
+
+#if defined(_OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_MINPLUS_AVX2)
+
+inline void MinPlusRowUpdate(int32_t *row_i, const int32_t *row_k, int32_t distance_ik, int32_t infinite, int32_t length)
+{
+	int32_t j = 0;
+	__m256i distance_ik_vec = _mm256_set1_epi32(distance_ik), infinite_vec = _mm256_set1_epi32(infinite);
+	for (; j + 8 <= length; j += 8) {
+		__m256i row_k_vec = _mm256_loadu_si256((const __m256i *)(row_k + j)), row_i_vec = _mm256_loadu_si256((const __m256i *)(row_i + j));
+		__m256i min_vec = _mm256_min_epi32(_mm256_add_epi32(distance_ik_vec, row_k_vec), row_i_vec);
+		_mm256_storeu_si256((__m256i *)(row_i + j), _mm256_blendv_epi8(row_i_vec, min_vec, _mm256_cmpgt_epi32(infinite_vec, row_k_vec)));
+	}
+	for (; j < length; j++)
+		row_i[j] = ((row_k[j] < infinite) && (distance_ik + row_k[j] < row_i[j])) ? distance_ik + row_k[j] : row_i[j];
+}
+
+
+inline void MinPlusRowUpdate(float *row_i, const float *row_k, float distance_ik, float infinite, int32_t length)
+{
+	int32_t j = 0;
+	__m256 distance_ik_vec = _mm256_set1_ps(distance_ik), infinite_vec = _mm256_set1_ps(infinite);
+	for (; j + 8 <= length; j += 8) {
+		__m256 row_k_vec = _mm256_loadu_ps(row_k + j), row_i_vec = _mm256_loadu_ps(row_i + j);
+		__m256 min_vec = _mm256_min_ps(_mm256_add_ps(distance_ik_vec, row_k_vec), row_i_vec);
+		_mm256_storeu_ps(row_i + j, _mm256_blendv_ps(row_i_vec, min_vec, _mm256_cmp_ps(row_k_vec, infinite_vec, _CMP_LT_OQ)));
+	}
+	for (; j < length; j++)
+		row_i[j] = ((row_k[j] < infinite) && (distance_ik + row_k[j] < row_i[j])) ? distance_ik + row_k[j] : row_i[j];
+}
+
+#elif defined(_OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_MINPLUS_SSE41)
+
+inline void MinPlusRowUpdate(int32_t *row_i, const int32_t *row_k, int32_t distance_ik, int32_t infinite, int32_t length)
+{
+	int32_t j = 0;
+	__m128i distance_ik_vec = _mm_set1_epi32(distance_ik), infinite_vec = _mm_set1_epi32(infinite);
+	for (; j + 4 <= length; j += 4) {
+		__m128i row_k_vec = _mm_loadu_si128((const __m128i *)(row_k + j)), row_i_vec = _mm_loadu_si128((const __m128i *)(row_i + j));
+		__m128i min_vec = _mm_min_epi32(_mm_add_epi32(distance_ik_vec, row_k_vec), row_i_vec);
+		_mm_storeu_si128((__m128i *)(row_i + j), _mm_blendv_epi8(row_i_vec, min_vec, _mm_cmpgt_epi32(infinite_vec, row_k_vec)));
+	}
+	for (; j < length; j++)
+		row_i[j] = ((row_k[j] < infinite) && (distance_ik + row_k[j] < row_i[j])) ? distance_ik + row_k[j] : row_i[j];
+}
+
+
+inline void MinPlusRowUpdate(float *row_i, const float *row_k, float distance_ik, float infinite, int32_t length)
+{
+	int32_t j = 0;
+	__m128 distance_ik_vec = _mm_set1_ps(distance_ik), infinite_vec = _mm_set1_ps(infinite);
+	for (; j + 4 <= length; j += 4) {
+		__m128 row_k_vec = _mm_loadu_ps(row_k + j), row_i_vec = _mm_loadu_ps(row_i + j);
+		__m128 min_vec = _mm_min_ps(_mm_add_ps(distance_ik_vec, row_k_vec), row_i_vec);
+		_mm_storeu_ps(row_i + j, _mm_blendv_ps(row_i_vec, min_vec, _mm_cmplt_ps(row_k_vec, infinite_vec)));
+	}
+	for (; j < length; j++)
+		row_i[j] = ((row_k[j] < infinite) && (distance_ik + row_k[j] < row_i[j])) ? distance_ik + row_k[j] : row_i[j];
+}
+
+#endif
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_MINPLUSKERNEL_H
@@ -36,7 +36,7 @@ public:
 
 	Node();
 	Node(const T1& data_val, const T2& index);
-	~Node();
+	~Node() = default;		// Trivial, so that a Node of trivially copyable data is stored as is in a binary Graph file
 };
 
 
@@ -55,11 +55,4 @@ Node<T1, T2>::Node(const T1& data_val, const T2& index)
 }
 
 
-template<typename T1, typename T2>
-Node<T1, T2>::~Node()
-{
-	
-}
-
-
 #endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_NODE_H
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// PathTracer.hpp: Contains the tracer policies that observe the Shortest Path algorithms of the Graph class
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_PATHTRACER_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_PATHTRACER_H
+
+#include "GraphResults.hpp"
+#include "GraphPrinter.hpp"
+
+#include <iostream>
+#include <vector>
+
+#include <stdint.h>
+
+// Tracer policy of the Single Source Shortest Path algorithms, passed as a template parameter so that every call is resolved at
+// compile time. The algorithms call
+//   Relaxation(u, v, distance)      the distance of v was lowered to distance through the edge u-->v
+//   QueuePush(v) / QueuePop(v)      v entered / left the heap, queue or bucket of the algorithm
+//   Iteration(k, result)            iteration k is over, result holds the current distances and predecessors
+// Iteration is only called when LABEL_SNAPSHOTS is true, since some algorithms have to gather their labels first.
+// The parallel Delta-Stepping and Bellman-Ford only report Iterations; the predecessor of a snapshot is the vertex whose
+// relaxation set the current distance, the final predecessors are rebuilt as a shortest path tree
+template<typename T2>
+struct NullPathTracer {
+	static const bool LABEL_SNAPSHOTS = false;
+
+	void Relaxation(int32_t /*start_vertex*/, int32_t /*end_vertex*/, const T2 &/*distance*/)		{ }
+	void QueuePush(int32_t /*vertex*/)		{ }
+	void QueuePop(int32_t /*vertex*/)		{ }
+	void Iteration(int64_t /*iteration*/, const ShortestPathResult<T2> &/*result*/)		{ }
+};
+
+
+// Prints the labels of all the vertices after every iteration: "\nIteration k: [(uuid->distance,predecessor_uuid);...]"
+template<typename T1, typename T2>
+class ConsolePathTracer : public NullPathTracer<T2> {
+private:
+	const Graph<T1, T2> &graph_;
+	std::ostream &out_;
+
+public:
+	static const bool LABEL_SNAPSHOTS = true;
+
+	ConsolePathTracer(const Graph<T1, T2> &graph, std::ostream &out = std::cout) : graph_(graph), out_(out) { }
+
+	void Iteration(int64_t iteration, const ShortestPathResult<T2> &result) {
+		out_ << "\nIteration " << iteration << ": [" << GraphPrinter<T1, T2>::LabelsString(graph_, result.distances_, result.predecessors_, result.sourceVertex_) << "]";
+	}
+};
+
+
+// Records every event, e.g. to count the relaxations or to replay the label changes in a test
+template<typename T2>
+class RecordingPathTracer {
+public:
+	static const bool LABEL_SNAPSHOTS = true;
+
+	std::vector<std::pair<std::pair<int32_t, int32_t>, T2> > relaxations_;		// ((Start vertex, End vertex), New distance)
+	std::vector<int32_t> pushedVertices_;
+	std::vector<int32_t> poppedVertices_;
+	std::vector<ShortestPathResult<T2> > snapshots_;		// Labels after every iteration
+
+	void Relaxation(int32_t start_vertex, int32_t end_vertex, const T2 &distance) {
+		relaxations_.push_back(std::pair<std::pair<int32_t, int32_t>, T2>(std::pair<int32_t, int32_t>(start_vertex, end_vertex), distance));
+	}
+	void QueuePush(int32_t vertex)		{ pushedVertices_.push_back(vertex); }
+	void QueuePop(int32_t vertex)		{ poppedVertices_.push_back(vertex); }
+	void Iteration(int64_t /*iteration*/, const ShortestPathResult<T2> &result)		{ snapshots_.push_back(result); }
+};
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_PATHTRACER_H
@@ -0,0 +1,93 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// SearchSpace.hpp: Contains the reusable labels of one direction of a point-to-point shortest path search
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_SEARCHSPACE_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_SEARCHSPACE_H
+
+#include "IndexedHeap.hpp"
+
+#include <vector>
+
+#include <stdint.h>
+
+// Distances, parents and heap of one direction (forward from the source or backward from the target) of a point-to-point search.
+// The labeled vertices are remembered, so Reset costs O(vertices touched by the last query) instead of O(V): a query that only
+// explores the neighbourhood of its endpoints does not pay for the whole Graph
+template<typename T2>
+class SearchSpace {
+private:
+	std::vector<T2> distances_;
+	std::vector<int32_t> parents_;
+	std::vector<int32_t> touchedVertices_;
+	T2 infiniteWeight_;
+
+public:
+	IndexedHeap<T2> heap_;
+
+	SearchSpace() : infiniteWeight_(T2(0)) { }
+
+	void Resize(int32_t num_vertices, const T2 &infinite_weight);
+	void Reset();
+
+	int32_t NumVertices() const		{ return int32_t(distances_.size()); }
+	int64_t NumTouchedVertices() const		{ return int64_t(touchedVertices_.size()); }
+	bool Reached(int32_t vertex) const		{ return distances_[vertex] < infiniteWeight_; }
+	const T2& Distance(int32_t vertex) const		{ return distances_[vertex]; }
+	int32_t Parent(int32_t vertex) const		{ return parents_[vertex]; }
+
+	void Label(int32_t vertex, const T2 &distance, int32_t parent);
+};
+
+
+template<typename T2>
+void SearchSpace<T2>::Resize(int32_t num_vertices, const T2 &infinite_weight)
+{
+	infiniteWeight_ = infinite_weight;
+	distances_.assign(num_vertices, infinite_weight);
+	parents_.assign(num_vertices, -1);
+	touchedVertices_.clear();
+	heap_.Resize(num_vertices);
+}
+
+
+template<typename T2>
+void SearchSpace<T2>::Reset()
+{
+	for (const auto &elem : touchedVertices_) {
+		distances_[elem] = infiniteWeight_;
+		parents_[elem] = -1;
+	}
+	touchedVertices_.clear();
+	heap_.Clear();
+}
+
+
+template<typename T2>
+void SearchSpace<T2>::Label(int32_t vertex, const T2 &distance, int32_t parent)
+{
+	if (!Reached(vertex))		touchedVertices_.push_back(vertex);
+	distances_[vertex] = distance;
+	parents_[vertex] = parent;
+}
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_SEARCHSPACE_H
@@ -0,0 +1,202 @@
+// Robin Kalia
+// robinkalia@berkeley.edu
+// Graphs: Class that contains implementation of various Graph Algorithms
+//
+// ThreadPool.hpp: Contains the declaration and definition of different data members and methods of the ThreadPool class
+
+/*
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_THREADPOOL_H
+#define _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+#include <stdint.h>
+
+// Fixed set of worker threads that run one task at a time on every thread and block the caller until all of them finish
+// The calling thread acts as thread 0, so a pool of N threads only spawns N-1 workers and a pool of 1 thread runs inline.
+// Concurrent callers of Run take turns; a task must not call Run on its own pool
+class ThreadPool {
+private:
+	int32_t numThreads_;
+	std::vector<std::thread> workers_;
+
+	std::mutex runMutex_;		// Held by the caller of Run for the whole task
+	std::mutex mutex_;
+	std::condition_variable taskCondition_;
+	std::condition_variable doneCondition_;
+	const std::function<void(int32_t)> *task_;
+	int64_t taskGeneration_;
+	int32_t numBusyWorkers_;
+	std::exception_ptr taskException_;		// First exception thrown by the current task on any thread
+	bool stop_;
+
+	void SetTaskException(std::exception_ptr exception);
+
+	void WorkerLoop(int32_t thread_id);
+
+public:
+	ThreadPool(int32_t num_threads = 0);		// num_threads = 0 --> One thread per hardware core
+	~ThreadPool();
+
+	int32_t NumThreads() const		{ return numThreads_; }
+
+	void Run(const std::function<void(int32_t)> &task);		// Calls task(thread_id) once on every thread, rethrows the first exception
+	void ParallelFor(int64_t begin_index, int64_t end_index, const std::function<void(int64_t, int64_t, int32_t)> &body, int64_t grain_size = 1024);
+
+	static int32_t HardwareThreads();
+};
+
+
+inline int32_t ThreadPool::HardwareThreads()
+{
+	int32_t num_threads = int32_t(std::thread::hardware_concurrency());
+	return (num_threads > 0) ? num_threads : 1;
+}
+
+
+inline ThreadPool::ThreadPool(int32_t num_threads) : task_(nullptr), taskGeneration_(0), numBusyWorkers_(0), stop_(false)
+{
+	numThreads_ = (num_threads > 0) ? num_threads : HardwareThreads();
+	for (int32_t i = 1; i < numThreads_; i++)
+		workers_.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+}
+
+
+inline ThreadPool::~ThreadPool()
+{
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	taskCondition_.notify_all();
+
+	for (auto &elem : workers_)		elem.join();
+	workers_.clear();
+}
+
+
+inline void ThreadPool::WorkerLoop(int32_t thread_id)
+{
+	int64_t seen_generation = 0;
+	while (true) {
+		const std::function<void(int32_t)> *task = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			while ((!stop_) && (taskGeneration_ == seen_generation))		taskCondition_.wait(lock);
+			if (stop_)		return;
+
+			seen_generation = taskGeneration_;
+			task = task_;
+		}
+
+		try {
+			(*task)(thread_id);
+		}
+		catch (...) {
+			SetTaskException(std::current_exception());
+		}
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (--numBusyWorkers_ == 0)		doneCondition_.notify_one();
+	}
+}
+
+
+inline void ThreadPool::SetTaskException(std::exception_ptr exception)
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (!taskException_)		taskException_ = exception;
+}
+
+
+// The caller waits for every worker even when a thread throws, so that no worker is left running a task whose captures are gone
+inline void ThreadPool::Run(const std::function<void(int32_t)> &task)
+{
+	if (workers_.empty()) {
+		task(0);
+		return;
+	}
+
+	std::unique_lock<std::mutex> run_lock(runMutex_);
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		task_ = &task;
+		numBusyWorkers_ = int32_t(workers_.size());
+		++taskGeneration_;
+	}
+	taskCondition_.notify_all();
+
+	try {
+		task(0);
+	}
+	catch (...) {
+		SetTaskException(std::current_exception());
+	}
+
+	std::exception_ptr exception;
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		while (numBusyWorkers_ > 0)		doneCondition_.wait(lock);
+		task_ = nullptr;
+		exception.swap(taskException_);
+	}
+	if (exception)		std::rethrow_exception(exception);
+}
+
+
+// Splits [begin_index, end_index) into chunks of grain_size that the threads claim dynamically, so uneven
+// chunks (e.g. high degree vertices) do not leave the other threads idle. body(chunk_begin, chunk_end, thread_id)
+// Once body throws, the remaining chunks are not claimed and Run rethrows the exception
+inline void ThreadPool::ParallelFor(int64_t begin_index, int64_t end_index, const std::function<void(int64_t, int64_t, int32_t)> &body, int64_t grain_size)
+{
+	if (begin_index >= end_index)		return;
+	if (grain_size < 1)		grain_size = 1;
+
+	if ((workers_.empty()) || (end_index - begin_index <= grain_size)) {
+		body(begin_index, end_index, 0);
+		return;
+	}
+
+	std::atomic<int64_t> next_index(begin_index);
+	std::function<void(int32_t)> task = [&](int32_t thread_id) {
+		while (true) {
+			int64_t chunk_begin = next_index.fetch_add(grain_size);
+			if (chunk_begin >= end_index)		break;
+
+			int64_t chunk_end = (chunk_begin + grain_size < end_index) ? chunk_begin + grain_size : end_index;
+			try {
+				body(chunk_begin, chunk_end, thread_id);
+			}
+			catch (...) {
+				next_index.store(end_index);
+				throw;
+			}
+		}
+	};
+
+	Run(task);
+}
+
+
+#endif		// _OPENSOURCE_DATASTRUCTS_ALGOS_GRAPH_THREADPOOL_H
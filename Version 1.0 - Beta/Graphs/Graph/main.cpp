@@ -23,6 +23,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "Graph.hpp"
 
 #include <string>
+#include <fstream>
 
 template<typename T1, typename T2>
 void CreateSampleAdjacencyMatrix(std::vector<std::pair<Node<T1>, std::vector<T2> > > &adjacency_mat, int32_t offset=0);
@@ -54,6 +55,22 @@ int32_t main(int32_t argc, char* argv[])
 			std::cout << elem << (elem == bfs_traversal_edge_list[bfs_traversal_edge_list.size() - 1] ? " }" : ", ");
 		std::cout << std::endl;
 
+		// Direction-Optimizing Breadth First Search
+		TraversalResult bfs_result;
+		graph.BreadthFirstSearch(bfs_result);
+		std::cout << "\nDirection-Optimizing BFS (Vertex: Parent, Level): { ";
+		for (int32_t i = 0; i < graph.NumNodes(); i++)
+			std::cout << i << ": " << bfs_result.parents_[i] << ", " << bfs_result.levels_[i] << ((i == graph.NumNodes() - 1) ? " }" : "; ");
+		std::cout << std::endl;
+
+		// Multithreaded Level-Synchronous Breadth First Search
+		graph.SetNumThreads(4);
+		graph.ParallelBreadthFirstSearch(bfs_result);
+		std::cout << "\nParallel BFS (Vertex: Level): { ";
+		for (int32_t i = 0; i < graph.NumNodes(); i++)
+			std::cout << i << ": " << bfs_result.levels_[i] << ((i == graph.NumNodes() - 1) ? " }" : "; ");
+		std::cout << std::endl;
+
 		// Depth First Search
 		std::vector<std::string> dfs_edges_list = {};
 		std::vector<std::pair<int64_t, int64_t> > dfs_traversal_edge_list = {};
@@ -78,6 +95,35 @@ int32_t main(int32_t argc, char* argv[])
 				std::cout << elem << (elem == cycle_terminal_vertices_list[cycle_terminal_vertices_list.size() - 1] ? " }\n" : ", ");
 		}
 
+		// Cycles of an Undirected Graph: the square 201-202-203-204 with the pendant vertex 205 on 203 holds one cycle
+		std::vector<std::pair<Node<int32_t>, std::vector<int32_t> > > undirected_mat;
+		std::vector<std::vector<int32_t> > undirected_mat_elems = {	{ 0, 1, 0, 1, 0 },
+																	{ 1, 0, 1, 0, 0 },
+																	{ 0, 1, 0, 1, 1 },
+																	{ 1, 0, 1, 0, 0 },
+																	{ 0, 0, 1, 0, 0 }
+																};
+		for (int32_t i = 0; i < int32_t(undirected_mat_elems.size()); i++)
+			undirected_mat.push_back(std::pair<Node<int32_t>, std::vector<int32_t> >(Node<int32_t>(i + 1, 201 + i), undirected_mat_elems[i]));
+		Graph<int32_t, int32_t> undirected_graph(undirected_mat);
+		cycle_terminal_vertices_list = {};
+		undirected_graph.FindCycles(cycle_terminal_vertices_list, 0);
+		std::cout << "\nUndirected Cycle Detection: ";
+		if (cycle_terminal_vertices_list.size() == 0)
+			std::cout << "No Cycle Detected" << std::endl;
+		else {
+			std::cout << "Number of Detected Cycles = " << cycle_terminal_vertices_list.size() << "\nCycle Terminal Vertices List: { ";
+			for (const auto& elem : cycle_terminal_vertices_list)
+				std::cout << elem << (elem == cycle_terminal_vertices_list[cycle_terminal_vertices_list.size() - 1] ? " }\n" : ", ");
+		}
+
+		// Vertices that share a Cycle (Strongly Connected Components)
+		std::vector<std::string> cycle_components_list = {};
+		graph.FindCycles(cycle_components_list, 2);
+		std::cout << "\nCyclic Strongly Connected Components: { ";
+		for (const auto& elem : cycle_components_list)
+			std::cout << elem << (elem == cycle_components_list[cycle_components_list.size() - 1] ? " }\n" : ", ");
+
 		// Topological Sort
 		std::vector<std::string> topological_sort_vertices_list = {};
 		graph.TopologicalSort(topological_sort_vertices_list);
@@ -89,34 +135,94 @@ int32_t main(int32_t argc, char* argv[])
 				std::cout << elem << (elem == topological_sort_vertices_list[topological_sort_vertices_list.size() - 1] ? " }\n" : ", ");
 		}
 
-		// Shortest Path
+		// Shortest Path: the console tracer prints the labels of all the vertices after every iteration
+		ConsolePathTracer<int32_t, int32_t> path_tracer(graph);
 		std::vector<std::string> shortest_path = {};
 		int32_t vertex_id = 4;
 		std::cout << "\nShortest Path from Vertex " << vertex_id << " with Dijkstra Algorithm";
-		graph.ShortestPathAlgorithm(shortest_path, 0, vertex_id);
+		graph.ShortestPathAlgorithm(shortest_path, 0, vertex_id, path_tracer);
 		for (const auto& elem : shortest_path)
 			std::cout << elem << (elem == shortest_path[shortest_path.size() - 1] ? "\n" : "");
 		
 		shortest_path = {};
 		vertex_id = 5;
 		std::cout << "\nShortest Path from Vertex " << vertex_id << " with Ford Algorithm";
-		graph.ShortestPathAlgorithm(shortest_path, 1, vertex_id);
+		graph.ShortestPathAlgorithm(shortest_path, 1, vertex_id, path_tracer);
 		for (const auto& elem : shortest_path)
 			std::cout << elem << (elem == shortest_path[shortest_path.size() - 1] ? "\n" : "");
 
 		shortest_path = {};
 		vertex_id = 6;
 		std::cout << "\nShortest Path from Vertex " << vertex_id << " with Generic Label Correcting Algorithm";
-		graph.ShortestPathAlgorithm(shortest_path, 2, vertex_id);
+		graph.ShortestPathAlgorithm(shortest_path, 2, vertex_id, path_tracer);
+		for (const auto& elem : shortest_path)
+			std::cout << elem << (elem == shortest_path[shortest_path.size() - 1] ? "\n" : "");
+
+		shortest_path = {};
+		vertex_id = 4;
+		std::cout << "\nShortest Path from Vertex " << vertex_id << " with Parallel Delta-Stepping Algorithm";
+		graph.SetNumThreads(4);
+		graph.ShortestPathAlgorithm(shortest_path, 4, vertex_id, path_tracer);
 		for (const auto& elem : shortest_path)
 			std::cout << elem << (elem == shortest_path[shortest_path.size() - 1] ? "\n" : "");
 
 		shortest_path = {};
+		vertex_id = 5;
+		std::cout << "\nShortest Path from Vertex " << vertex_id << " with Parallel Bellman-Ford Algorithm";
+		graph.ShortestPathAlgorithm(shortest_path, 5, vertex_id, path_tracer);
+		for (const auto& elem : shortest_path)
+			std::cout << elem << (elem == shortest_path[shortest_path.size() - 1] ? "\n" : "");
+
+		PointToPointResult<int32_t> point_to_point_result;
+		std::vector<std::string> path_vertices_list = {};
+		graph.PointToPointShortestPath(point_to_point_result, 0, 6);
+		GraphPrinter<int32_t, int32_t>::WritePath(graph, point_to_point_result, path_vertices_list);
+		std::cout << "\nBidirectional Dijkstra Path from Vertex 0 to Vertex 6 (Distance = " << point_to_point_result.distance_ << "): { ";
+		for (size_t i = 0; i < path_vertices_list.size(); i++)
+			std::cout << path_vertices_list[i] << ((i + 1 == path_vertices_list.size()) ? " }\n" : ", ");
+
+		path_vertices_list = {};
+		graph.PreprocessLandmarks(2);
+		graph.PointToPointShortestPath(point_to_point_result, 0, 6, 1);
+		GraphPrinter<int32_t, int32_t>::WritePath(graph, point_to_point_result, path_vertices_list);
+		std::cout << "\nA* with 2 Landmarks Path from Vertex 0 to Vertex 6 (Distance = " << point_to_point_result.distance_ << ", Settled Vertices = "
+			<< point_to_point_result.numSettledVertices_ << "): { ";
+		for (size_t i = 0; i < path_vertices_list.size(); i++)
+			std::cout << path_vertices_list[i] << ((i + 1 == path_vertices_list.size()) ? " }\n" : ", ");
+
+		path_vertices_list = {};
+		graph.BuildContractionHierarchy();
+		graph.PointToPointShortestPath(point_to_point_result, 0, 6, 2);
+		GraphPrinter<int32_t, int32_t>::WritePath(graph, point_to_point_result, path_vertices_list);
+		std::cout << "\nContraction Hierarchy (" << graph.GetContractionHierarchy().NumShortcuts() << " Shortcuts) Path from Vertex 0 to Vertex 6 (Distance = "
+			<< point_to_point_result.distance_ << "): { ";
+		for (size_t i = 0; i < path_vertices_list.size(); i++)
+			std::cout << path_vertices_list[i] << ((i + 1 == path_vertices_list.size()) ? " }\n" : ", ");
+
+		shortest_path = {};
+		vertex_id = 6;
 		std::cout << "\nAll-To-All Shortest Path for nodes " << vertex_id << " with WFI Algorithm\n";
 		graph.ShortestPathAlgorithm(shortest_path, 3, vertex_id);
 		for (const auto& elem : shortest_path)
 			std::cout << elem << (elem == shortest_path[shortest_path.size() - 1] ? "\n" : "");
 
+		shortest_path = {};
+		std::cout << "\nAll-To-All Shortest Path with Parallel Johnson Algorithm\n";
+		graph.ShortestPathAlgorithm(shortest_path, 6);
+		for (const auto& elem : shortest_path)
+			std::cout << elem << (elem == shortest_path[shortest_path.size() - 1] ? "\n" : "");
+
+		// The callback runs concurrently on the pool threads, every source only writes its own slot
+		std::vector<int32_t> source_list = { 0, 3, 5 };
+		std::vector<int32_t> distance_to_vertex_6_list(source_list.size());
+		graph.MultiSourceShortestPath(source_list, [&](const ShortestPathResult<int32_t> &result, int32_t /*thread_id*/) {
+			for (size_t i = 0; i < source_list.size(); i++)
+				if (source_list[i] == result.sourceVertex_)		distance_to_vertex_6_list[i] = result.distances_[6];
+		});
+		std::cout << "\nMulti-Source Dijkstra Distances to Vertex 6: { ";
+		for (size_t i = 0; i < source_list.size(); i++)
+			std::cout << source_list[i] << ": " << distance_to_vertex_6_list[i] << ((i + 1 == source_list.size()) ? " }\n" : "; ");
+
 		// Minimum Spanning Tree
 		std::vector<std::string> mst_adjacency_matrix = {};
 		std::cout << "\nMinimum Spanning Tree with Kruskal Algorithm\n";
@@ -125,11 +231,57 @@ int32_t main(int32_t argc, char* argv[])
 			std::cout << elem << (elem == shortest_path[shortest_path.size() - 1] ? "\n" : "");
 
 		mst_adjacency_matrix = {};
-		std::cout << "\nMinimum Spanning Tree with Dijkstra Algorithm\n";
-		graph.MinimumSpanningTree(mst_adjacency_matrix, 1);
+		std::cout << "\nMinimum Spanning Tree with Prim Algorithm\n";
+		graph.MinimumSpanningTree(mst_adjacency_matrix, 2);
+		for (const auto& elem : mst_adjacency_matrix)
+			std::cout << elem << (elem == shortest_path[shortest_path.size() - 1] ? "\n" : "");
+
+		mst_adjacency_matrix = {};
+		std::cout << "\nMinimum Spanning Tree with Parallel Boruvka Algorithm\n";
+		graph.MinimumSpanningTree(mst_adjacency_matrix, 3);
 		for (const auto& elem : mst_adjacency_matrix)
 			std::cout << elem << (elem == shortest_path[shortest_path.size() - 1] ? "\n" : "");
 
+		SpanningTreeResult<int32_t> mst_result;
+		graph.MinimumSpanningTree(mst_result, 0);
+		std::cout << "\nMinimum Spanning Tree: " << mst_result.edges_.size() << " Edges, Total Weight = " << mst_result.totalWeight_ << std::endl;
+
+		// Binary Graph file: the loaded Graph maps the file and uses its arrays in place
+		graph.SaveGraphFile("SampleGraph.bin");
+		Graph<int32_t, int32_t> mapped_graph("SampleGraph.bin");
+		ShortestPathResult<int32_t> mapped_result;
+		mapped_graph.ShortestPathAlgorithm(mapped_result, 0, 0);
+		std::cout << "\nMapped Graph File: " << mapped_graph.NumNodes() << " Nodes, Dijkstra Distances from Vertex 0: { ";
+		for (int32_t v = 0; v < mapped_graph.NumNodes(); v++)
+			std::cout << mapped_graph.GetNode(v).uuid_ << ": " << mapped_result.distances_[v] << ((v + 1 == mapped_graph.NumNodes()) ? " }\n" : "; ");
+
+		// Text edge list "u v w" with node uuids, parsed in parallel by GraphLoader
+		std::ofstream edge_list_file("SampleGraph.txt");
+		edge_list_file << "# Sample Graph: from_uuid to_uuid weight\n";
+		for (int32_t i = 0; i < int32_t(adjacency_mat.size()); i++)
+			for (int32_t j = 0; j < int32_t(adjacency_mat.size()); j++)
+				if (adjacency_mat[i].second[j] > 0)
+					edge_list_file << adjacency_mat[i].first.uuid_ << "\t" << adjacency_mat[j].first.uuid_ << "\t" << adjacency_mat[i].second[j] << "\n";
+		edge_list_file.close();
+		Graph<int32_t, int32_t> loaded_graph = Graph<int32_t, int32_t>::LoadEdgeList("SampleGraph.txt", 0, 4);
+		ShortestPathResult<int32_t> loaded_result;
+		loaded_graph.ShortestPathAlgorithm(loaded_result, 0, 0);
+		std::cout << "\nEdge List File: " << loaded_graph.NumNodes() << " Nodes, Dijkstra Distances from Vertex 0: { ";
+		for (int32_t v = 0; v < loaded_graph.NumNodes(); v++)
+			std::cout << loaded_graph.GetNode(v).uuid_ << ": " << loaded_result.distances_[v] << ((v + 1 == loaded_graph.NumNodes()) ? " }\n" : "; ");
+
+		// Dynamic mutations: logged, then merged into the CSR once by the next algorithm
+		int32_t new_vertex = loaded_graph.AddVertex(Node<int32_t>(8, 108));
+		loaded_graph.AddEdge(0, new_vertex, 1);
+		loaded_graph.AddEdge(new_vertex, 6, 1);
+		loaded_graph.UpdateWeight(0, 1, 5);
+		loaded_graph.RemoveEdge(1, 3);
+		std::cout << "\nPending Updates: " << loaded_graph.NumPendingUpdates();
+		loaded_graph.ShortestPathAlgorithm(loaded_result, 0, 0);
+		std::cout << "\nUpdated Graph: " << loaded_graph.NumNodes() << " Nodes, Dijkstra Distances from Vertex 0: { ";
+		for (int32_t v = 0; v < loaded_graph.NumNodes(); v++)
+			std::cout << loaded_graph.GetNode(v).uuid_ << ": " << loaded_result.distances_[v] << ((v + 1 == loaded_graph.NumNodes()) ? " }\n" : "; ");
+
 	}
 	catch (const std::exception& ex) {
 		std::string error = "\nCaught Error: " + std::string(ex.what());